@@ -0,0 +1,394 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "ngine.h"
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+
+#include <Components/BoundingBoxCollisionShapeComponent.h>
+#include <BaseEntity.h>
+#include <Game.h>
+#include <Matrix.h>
+#include <Resources.h>
+#include <Scene.h>
+#include <Vector2.h>
+#include <Graphics/Drawing.h>
+#include <Physics/BoundingBox.h>
+#include <Physics/Polygon.h>
+#include <UI/Controls/VerticalPanel.h>
+#include <UI/UIControlSized.h>
+
+using namespace NGINE_NS;
+using namespace NGINE_NS::Components;
+using namespace NGINE_NS::Physics;
+using namespace NGINE_NS::UI;
+using namespace NGINE_NS::UI::Controls;
+
+/*
+ * Samples taken per benchmark
+ */
+static const int SampleCount = 15;
+
+/*
+ * The result of one benchmark
+ */
+struct TBenchResult {
+    /*
+     * Benchmark name
+     */
+    std::string Name;
+
+    /*
+     * Operations per sample
+     */
+    size_t Operations = 0;
+
+    /*
+     * Fastest sample, in nanoseconds per operation
+     */
+    double Min = 0;
+
+    /*
+     * Median sample, in nanoseconds per operation
+     */
+    double Median = 0;
+
+    /*
+     * Slowest sample, in nanoseconds per operation
+     */
+    double Max = 0;
+};
+
+/*
+ * Keeps the compiler from removing work whose result is unused
+ */
+static volatile float Sink = 0;
+
+/*
+ * Time func_ over a number of samples.
+ * Each call of func_ must perform operations_ operations.
+ */
+static TBenchResult RunBench(const std::string &name_, size_t operations_, const std::function<void()> &func_) {
+    // Warm up caches and lazily built state
+    func_();
+
+    std::vector<double> samples;
+    for (auto i = 0; i < SampleCount; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func_();
+        auto end = std::chrono::steady_clock::now();
+
+        auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(ns / static_cast<double>(operations_));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    TBenchResult result;
+    result.Name = name_;
+    result.Operations = operations_;
+    result.Min = samples.front();
+    result.Median = samples[samples.size() / 2];
+    result.Max = samples.back();
+
+    std::cerr << name_ << ": " << result.Median << " ns/op" << std::endl;
+
+    return result;
+}
+
+// Test types
+
+class BenchEntity : public BaseEntity {
+public:
+    BenchEntity(Scene *scene_, TVector2 position_)
+        : BaseEntity(scene_, position_) {}
+};
+
+class BenchEntityB : public BaseEntity {
+public:
+    BenchEntityB(Scene *scene_, TVector2 position_)
+        : BaseEntity(scene_, position_) {}
+};
+
+class BenchEntityC : public BaseEntity {
+public:
+    BenchEntityC(Scene *scene_, TVector2 position_)
+        : BaseEntity(scene_, position_) {}
+};
+
+class BenchControl : public UIControlSized {
+public:
+    BenchControl(float width_, float height_) {
+        SetWidth(width_);
+        SetHeight(height_);
+    }
+};
+
+static int HandlerCalls = 0;
+
+static void BenchHandler(EventArgs &e_) {
+    HandlerCalls++;
+}
+
+// Benchmarks
+
+static TBenchResult BenchCollisionChecks(Game *game_, int shapes_) {
+    Scene scene(game_);
+    std::mt19937 random(1);
+
+    // Keep density constant so only the shape count changes
+    auto extent = std::sqrt(static_cast<float>(shapes_)) * 64.0f;
+    std::uniform_real_distribution<float> position(0, extent);
+
+    std::vector<BoundingBoxCollisionShapeComponent *> components;
+    for (auto i = 0; i < shapes_; i++) {
+        auto ent = new BenchEntity(&scene, {position(random), position(random)});
+        scene.AddEntity(ent);
+        components.push_back(ent->AddComponent("Collider", new BoundingBoxCollisionShapeComponent(ent, {0, 0, 32, 32})));
+    }
+
+    std::vector<TVector2> targets;
+    for (auto i = 0; i < 1000; i++) {
+        targets.emplace_back(position(random), position(random));
+    }
+
+    return RunBench("collision_check_at_" + std::to_string(shapes_), targets.size(), [&]() {
+        auto hits = 0;
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (components[i % components.size()]->CheckCollisionAt<BaseEntity>(targets[i]))
+                hits++;
+        }
+        Sink = static_cast<float>(hits);
+    });
+}
+
+static TBenchResult BenchEntityChurn(Game *game_) {
+    Scene scene(game_);
+    std::vector<BenchEntity *> entities(1000);
+
+    return RunBench("entity_add_remove", entities.size(), [&]() {
+        for (size_t i = 0; i < entities.size(); i++) {
+            entities[i] = new BenchEntity(&scene, {static_cast<float>(i), 0});
+            scene.AddEntity(entities[i]);
+        }
+
+        // Remove in a different order to the adds
+        for (auto i = entities.size(); i > 0; i--) {
+            entities[i - 1]->Destroy();
+        }
+    });
+}
+
+static TBenchResult BenchEventFanOut() {
+    EventHandler<EventArgs> handler;
+    for (auto i = 0; i < 1000; i++) {
+        handler.Bind(BenchHandler);
+    }
+
+    return RunBench("event_invoke_fan_out", 100 * 1000, [&]() {
+        for (auto i = 0; i < 100; i++) {
+            handler({});
+        }
+        Sink = static_cast<float>(HandlerCalls);
+    });
+}
+
+static TBenchResult BenchGetEntitiesByType(Game *game_) {
+    Scene scene(game_);
+    for (auto i = 0; i < 10000; i++) {
+        TVector2 pos = {static_cast<float>(i), 0};
+        switch (i % 3) {
+            case 0:
+                scene.AddEntity(new BenchEntity(&scene, pos));
+                break;
+            case 1:
+                scene.AddEntity(new BenchEntityB(&scene, pos));
+                break;
+            default:
+                scene.AddEntity(new BenchEntityC(&scene, pos));
+                break;
+        }
+    }
+
+    return RunBench("get_entities_by_type", 1000, [&]() {
+        auto sum = 0.0f;
+        for (auto i = 0; i < 1000; i++) {
+            const auto &entities = scene.GetEntitiesByTypeView<BenchEntityB>();
+            sum += entities[i % entities.size()]->GetPosition().X;
+        }
+        Sink = sum;
+    });
+}
+
+static TBenchResult BenchMatrixMath() {
+    std::vector<TMatrix> matrices;
+    for (auto i = 0; i < 1000; i++) {
+        matrices.push_back(TMatrix::RotateZ(static_cast<float>(i) * 0.01f) * TMatrix::Translate(static_cast<float>(i), 2, 0));
+    }
+
+    return RunBench("matrix_multiply_invert", matrices.size(), [&]() {
+        auto result = TMatrix::Identity;
+        for (const auto &matrix : matrices) {
+            result = (result * matrix).Invert();
+        }
+        Sink = result.M0;
+    });
+}
+
+static TBenchResult BenchPolygonPairs(const std::string &name_, float rotation_) {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> position(0, 256);
+
+    std::vector<TPolygon> polygons;
+    for (auto i = 0; i < 256; i++) {
+        polygons.push_back(TRectangle(position(random), position(random), 32, 32).ToPolygon(rotation_ * static_cast<float>(i)));
+    }
+
+    return RunBench(name_, polygons.size() * 16, [&]() {
+        auto hits = 0;
+        for (size_t i = 0; i < polygons.size(); i++) {
+            for (size_t j = 1; j <= 16; j++) {
+                if (polygons[i].CheckCollision(&polygons[(i + j) % polygons.size()]))
+                    hits++;
+            }
+        }
+        Sink = static_cast<float>(hits);
+    });
+}
+
+static TBenchResult BenchRenderCommands() {
+    // Record like a frame would, then sort and submit to a backend that only counts
+    Graphics::RenderCommandBuffer buffer;
+    Graphics::RecordingRenderBackend backend(false);
+    std::mt19937 random(4);
+    std::uniform_real_distribution<float> position(0, 1024);
+
+    std::vector<TVector2> positions;
+    for (auto i = 0; i < 10000; i++) {
+        positions.emplace_back(position(random), position(random));
+    }
+
+    return RunBench("render_commands_record_sort_submit", positions.size(), [&]() {
+        buffer.BeginRecording();
+        for (size_t i = 0; i < positions.size(); i++) {
+            Graphics::Drawing::SetDepth(static_cast<int>(i % 16));
+            Graphics::Drawing::DrawRectangle(positions[i], 16, 16, Graphics::TColor::White);
+        }
+        buffer.EndRecording();
+
+        buffer.Sort();
+        buffer.Submit(backend);
+        backend.Finish();
+        Sink = static_cast<float>(backend.GetCommandCount());
+    });
+}
+
+static TBenchResult BenchResourceLookups() {
+    // Headless games cannot load content, so this measures the lookup path with misses
+    std::vector<std::string> names;
+    for (auto i = 0; i < 1000; i++) {
+        names.push_back("textures/bench_" + std::to_string(i));
+    }
+
+    return RunBench("resources_lookup", names.size(), [&]() {
+        auto found = 0;
+        for (const auto &name : names) {
+            if (Resources::GetTexture(name) != nullptr)
+                found++;
+        }
+        Sink = static_cast<float>(found);
+    });
+}
+
+static TBenchResult BenchUIPanelLayout() {
+    VerticalPanel panel(400, 10000);
+    std::vector<BenchControl *> controls;
+    for (auto i = 0; i < 200; i++) {
+        auto control = new BenchControl(100, 20);
+        panel.AddChild("control" + std::to_string(i), control);
+        controls.push_back(control);
+    }
+
+    return RunBench("ui_panel_layout", controls.size(), [&]() {
+        auto sum = 0.0f;
+        for (auto control : controls) {
+            sum += control->GetRenderPosition().Y;
+        }
+        Sink = sum;
+    });
+}
+
+static TBenchResult BenchVectorMath() {
+    std::vector<TVector2> vectors;
+    for (auto i = 0; i < 10000; i++) {
+        vectors.emplace_back(static_cast<float>(i), static_cast<float>(i % 100));
+    }
+    auto matrix = TMatrix::RotateZ(0.5f) * TMatrix::Translate(4, 2, 0);
+
+    return RunBench("vector_math", vectors.size(), [&]() {
+        auto sum = 0.0f;
+        for (const auto &vector : vectors) {
+            auto transformed = vector.Transform(matrix);
+            sum += transformed.Dot(vector) + (transformed - vector).Magnitude();
+        }
+        Sink = sum;
+    });
+}
+
+/*
+ * Write results as JSON
+ */
+static void WriteResults(std::ostream &stream_, const std::vector<TBenchResult> &results_) {
+    stream_ << std::fixed << std::setprecision(3);
+    stream_ << "{\n  \"unit\": \"ns/op\",\n  \"samples\": " << SampleCount << ",\n  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results_.size(); i++) {
+        const auto &result = results_[i];
+        stream_ << "    {\"name\": \"" << result.Name << "\", \"operations\": " << result.Operations
+                << ", \"min\": " << result.Min << ", \"median\": " << result.Median << ", \"max\": " << result.Max
+                << "}" << (i + 1 < results_.size() ? "," : "") << "\n";
+    }
+
+    stream_ << "  ]\n}\n";
+}
+
+int main(int argc, char **argv) {
+    auto outPath = argc > 1 ? std::string(argv[1]) : std::string("bench_results.json");
+
+    Game game(1280, 768, 60, "NgineBench", HEADLESS);
+
+    std::vector<TBenchResult> results;
+    results.push_back(BenchEntityChurn(&game));
+    results.push_back(BenchEventFanOut());
+    results.push_back(BenchCollisionChecks(&game, 1000));
+    results.push_back(BenchCollisionChecks(&game, 10000));
+    results.push_back(BenchPolygonPairs("polygon_pairs_aligned", 0));
+    results.push_back(BenchPolygonPairs("polygon_pairs_rotated", 0.1f));
+    results.push_back(BenchVectorMath());
+    results.push_back(BenchMatrixMath());
+    results.push_back(BenchGetEntitiesByType(&game));
+    results.push_back(BenchRenderCommands());
+    results.push_back(BenchResourceLookups());
+    results.push_back(BenchUIPanelLayout());
+
+    std::ofstream file(outPath);
+    if (!file) {
+        std::cerr << "Failed to open " << outPath << std::endl;
+        return 1;
+    }
+
+    WriteResults(file, results);
+    std::cerr << "Results written to " << outPath << std::endl;
+    return 0;
+}
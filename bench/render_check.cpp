@@ -0,0 +1,169 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "ngine.h"
+
+#include <Vector2.h>
+#include <Graphics/Drawing.h>
+#include <Graphics/RenderBackend.h>
+#include <Graphics/RenderCommandBuffer.h>
+
+using namespace NGINE_NS;
+using namespace NGINE_NS::Graphics;
+
+/*
+ * Number of failed checks
+ */
+static int Failures = 0;
+
+/*
+ * Record a check result
+ */
+static void Check(bool passed_, const std::string &name_) {
+    if (!passed_) {
+        std::cerr << "FAILED: " << name_ << std::endl;
+        Failures++;
+    }
+}
+
+/*
+ * Record a marker draw, identified by its X position
+ */
+static void DrawMarker(int id_) {
+    Drawing::DrawPixel({static_cast<float>(id_), 0}, TColor::White);
+}
+
+/*
+ * Record a textured draw, identified by its X position.
+ * Nothing is sampled by the recording backend, so no texture is needed.
+ */
+static void DrawTexturedMarker(RenderCommandBuffer &buffer_, int id_, unsigned int textureID_) {
+    TRenderCommand command(COMMAND_TEXTURE);
+    command.Points[0] = {static_cast<float>(id_), 0};
+    command.TextureID = textureID_;
+    buffer_.Add(command);
+}
+
+/*
+ * Sort and submit a buffer, returning what the backend ran, as marker ids and -1 for anything else
+ */
+static std::vector<int> Submit(RenderCommandBuffer &buffer_, RecordingRenderBackend &backend_) {
+    backend_.Clear();
+    buffer_.Sort();
+    buffer_.Submit(backend_);
+    backend_.Finish();
+
+    std::vector<int> ids;
+    for (const auto &command : backend_.GetCommands()) {
+        if (command.Type == COMMAND_PIXEL || command.Type == COMMAND_TEXTURE)
+            ids.push_back(static_cast<int>(command.Points[0].X));
+        else
+            ids.push_back(-1);
+    }
+    return ids;
+}
+
+static void CheckDepthSorting(RecordingRenderBackend &backend_) {
+    RenderCommandBuffer buffer;
+    buffer.BeginRecording();
+
+    const int depths[] = {2, 0, 1, 0, 2, 1};
+    for (auto i = 0; i < 6; i++) {
+        Drawing::SetDepth(depths[i]);
+        DrawMarker(i);
+    }
+
+    buffer.EndRecording();
+
+    // Lower depths first, call order kept within a depth
+    Check(Submit(buffer, backend_) == std::vector<int>{1, 3, 2, 5, 0, 4}, "depth sorting is stable");
+}
+
+static void CheckPassBarriers(RecordingRenderBackend &backend_) {
+    RenderCommandBuffer nested;
+    nested.BeginRecording();
+    Drawing::SetDepth(-10);
+    DrawMarker(10);
+    nested.EndRecording();
+
+    RenderCommandBuffer buffer;
+    buffer.BeginRecording();
+
+    Drawing::SetDepth(5);
+    DrawMarker(0);
+    Drawing::Clear(TColor::Black);
+    Drawing::SetDepth(0);
+    DrawMarker(1);
+    Drawing::DrawCommandBuffer(nested);
+    Drawing::SetDepth(-5);
+    DrawMarker(2);
+
+    buffer.EndRecording();
+
+    // Depth never moves a draw across a clear or a nested buffer, which runs in place
+    Check(Submit(buffer, backend_) == std::vector<int>{0, -1, 1, 10, 2}, "draws stay within their pass");
+}
+
+static void CheckBatching(RecordingRenderBackend &backend_) {
+    RenderCommandBuffer buffer;
+
+    // Without batching, call order is kept at the same depth
+    buffer.BeginRecording();
+    DrawTexturedMarker(buffer, 0, 2);
+    DrawTexturedMarker(buffer, 1, 1);
+    DrawTexturedMarker(buffer, 2, 2);
+    buffer.EndRecording();
+
+    Check(Submit(buffer, backend_) == std::vector<int>{0, 1, 2}, "call order kept without batching");
+    Check(backend_.GetTextureChanges() == 3, "texture changes counted without batching");
+
+    // With batching, draws at a depth are grouped by blend mode, then texture
+    buffer.BeginRecording();
+    Drawing::SetBatching(true);
+    Drawing::SetBlendMode(BLEND_ADDITIVE);
+    DrawTexturedMarker(buffer, 0, 1);
+    Drawing::SetBlendMode(BLEND_ALPHA);
+    DrawTexturedMarker(buffer, 1, 2);
+    DrawTexturedMarker(buffer, 2, 1);
+    Drawing::SetBlendMode(BLEND_ADDITIVE);
+    DrawTexturedMarker(buffer, 3, 2);
+    DrawTexturedMarker(buffer, 4, 1);
+    Drawing::SetBlendMode(BLEND_ALPHA);
+    DrawTexturedMarker(buffer, 5, 2);
+
+    // Depth still comes first
+    Drawing::SetDepth(-1);
+    DrawTexturedMarker(buffer, 6, 2);
+    buffer.EndRecording();
+
+    Check(Submit(buffer, backend_) == std::vector<int>{6, 2, 1, 5, 0, 4, 3}, "batching groups by blend mode and texture");
+    Check(backend_.GetBlendChanges() == 1, "one blend change when batching");
+
+    const auto &commands = backend_.GetCommands();
+    Check(commands.size() == 7 && commands[4].Blend == BLEND_ADDITIVE && commands[3].Blend == BLEND_ALPHA,
+          "blend modes recorded with commands");
+}
+
+int main() {
+    RecordingRenderBackend backend(true);
+
+    CheckDepthSorting(backend);
+    CheckPassBarriers(backend);
+    CheckBatching(backend);
+
+    if (Failures > 0) {
+        std::cerr << Failures << " render checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cerr << "All render checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,546 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "ngine.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <new>
+#include <random>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <Components/BoundingBoxCollisionShapeComponent.h>
+#include <BaseEntity.h>
+#include <Game.h>
+#include <Scene.h>
+#include <Vector2.h>
+#include <Graphics/Camera.h>
+#include <Input/InputState.h>
+#include <UI/Controls/VerticalPanel.h>
+#include <UI/UIControlSized.h>
+#include <UI/UIWidget.h>
+
+using namespace NGINE_NS;
+using namespace NGINE_NS::Components;
+using namespace NGINE_NS::Graphics;
+using namespace NGINE_NS::Input;
+using namespace NGINE_NS::UI;
+using namespace NGINE_NS::UI::Controls;
+
+// Allocation counting
+
+/*
+ * Allocations made by the whole process.
+ * Shared library builds on Windows allocate through their own operator new, which is not counted.
+ */
+static std::atomic<std::uint64_t> AllocationCount{0};
+
+/*
+ * Bytes allocated by the whole process
+ */
+static std::atomic<std::uint64_t> AllocationBytes{0};
+
+void *operator new(std::size_t size_) {
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    AllocationBytes.fetch_add(size_, std::memory_order_relaxed);
+
+    auto ptr = std::malloc(size_ == 0 ? 1 : size_);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size_) {
+    return operator new(size_);
+}
+
+void operator delete(void *ptr_) noexcept {
+    std::free(ptr_);
+}
+
+void operator delete[](void *ptr_) noexcept {
+    std::free(ptr_);
+}
+
+void operator delete(void *ptr_, std::size_t) noexcept {
+    std::free(ptr_);
+}
+
+void operator delete[](void *ptr_, std::size_t) noexcept {
+    std::free(ptr_);
+}
+
+/*
+ * Get the peak resident set size of the process in kilobytes
+ */
+static std::uint64_t GetPeakRSS() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / 1024;
+    return 0;
+#else
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// Fixed input
+
+/*
+ * The input for a tick.
+ * The mouse circles the screen center and fires in bursts, the camera keys are held in turns.
+ */
+static TInputState MakeInput(unsigned int tick_) {
+    TInputState input;
+
+    auto angle = static_cast<float>(tick_) * 0.05f;
+    input.Mouse.Position = {640.0f + std::cos(angle) * 300.0f, 384.0f + std::sin(angle) * 300.0f};
+
+    auto firing = tick_ % 20 < 10;
+    input.Mouse.ButtonsDown[MOUSE_BUTTON_LEFT] = firing;
+    input.Mouse.ButtonsPressed[MOUSE_BUTTON_LEFT] = tick_ % 20 == 0;
+    input.Mouse.ButtonsReleased[MOUSE_BUTTON_LEFT] = tick_ % 20 == 10;
+
+    input.KeysDown[KEY_RIGHT] = tick_ % 240 < 120;
+    input.KeysDown[KEY_DOWN] = tick_ % 240 >= 120;
+
+    return input;
+}
+
+// Culling scenario
+
+class WandererEntity : public BaseEntity {
+    TVector2 _Velocity;
+public:
+    WandererEntity(Scene *scene_, TVector2 position_, TVector2 velocity_)
+        : BaseEntity(scene_, position_, 0, true), _Velocity(velocity_) {
+        SubscribeToUpdate();
+    }
+
+    void Update(EventArgs &e) override {
+        BaseEntity::Update(e);
+        MoveBy(_Velocity);
+    }
+};
+
+class CullingScene : public Scene {
+    TCamera _Camera;
+public:
+    CullingScene(Game *game_) : Scene(game_) {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(0, 20000);
+        std::uniform_real_distribution<float> velocity(-2, 2);
+
+        // Every tenth entity wanders, the rest are static props
+        for (auto i = 0; i < 50000; i++) {
+            TVector2 pos = {position(random), position(random)};
+            if (i % 10 == 0)
+                AddEntity(new WandererEntity(this, pos, {velocity(random), velocity(random)}));
+            else
+                AddEntity(new BaseEntity(this, pos, 0, true));
+        }
+
+        _Camera.Target = {10000, 10000};
+        SetActiveCamera(&_Camera);
+        SetCullArea(1280, 768, true);
+
+        OnUpdate.Bind(this, &CullingScene::MoveCamera);
+    }
+
+    void MoveCamera(EventArgs &e) {
+        const auto &input = GetInput();
+        if (input.IsKeyDown(KEY_RIGHT))
+            _Camera.Target.X += 40;
+        if (input.IsKeyDown(KEY_DOWN))
+            _Camera.Target.Y += 40;
+    }
+};
+
+// Shooter scenario
+
+class BulletEntity : public BaseEntity {
+    BoundingBoxCollisionShapeComponent *_Collider;
+    unsigned int _EnemyMask;
+    int _Life = 0;
+    TVector2 _Velocity;
+public:
+    BulletEntity(Scene *scene_, TVector2 position_, TVector2 velocity_, int life_)
+        : BaseEntity(scene_, position_), _Life(life_), _Velocity(velocity_) {
+        _Collider = AddComponent("Collider", new BoundingBoxCollisionShapeComponent(this, {0, 0, 4, 4}, "Bullets"));
+        _EnemyMask = scene_->GetCollisionLayerMask("Enemies");
+        SubscribeToUpdate();
+    }
+
+    void Fire(TVector2 position_, TVector2 velocity_, int life_) {
+        SetPosition(position_);
+        _Velocity = velocity_;
+        _Life = life_;
+    }
+
+    bool IsSpent() const {
+        return _Life <= 0;
+    }
+
+    void Update(EventArgs &e) override {
+        BaseEntity::Update(e);
+        if (_Life <= 0)
+            return;
+
+        MoveBy(_Velocity);
+        _Life--;
+
+        if (_Collider->CheckCollisionWith<BaseEntity>(_EnemyMask))
+            _Life = 0;
+    }
+};
+
+class ShooterScene : public Scene {
+    std::vector<BulletEntity *> _Bullets;
+    size_t _NextBullet = 0;
+    TVector2 _PlayerPosition = {640, 384};
+public:
+    ShooterScene(Game *game_) : Scene(game_) {
+        std::mt19937 random(2);
+        std::uniform_real_distribution<float> position(-1000, 2280);
+
+        // Register the enemy layer first, so bullets can find it
+        GetCollisionLayer("Enemies");
+
+        for (auto i = 0; i < 200; i++) {
+            auto enemy = new BaseEntity(this, {position(random), position(random)});
+            AddEntity(enemy);
+            enemy->AddComponent("Collider", new BoundingBoxCollisionShapeComponent(enemy, {0, 0, 48, 48}, "Enemies"));
+        }
+
+        // The pool starts full, spread along their paths
+        for (auto i = 0; i < 10000; i++) {
+            auto angle = static_cast<float>(i) * 0.618f;
+            TVector2 velocity = {std::cos(angle) * 8.0f, std::sin(angle) * 8.0f};
+            auto age = i % 120;
+            auto travelled = velocity;
+            travelled *= static_cast<float>(age);
+            auto bullet = new BulletEntity(this, _PlayerPosition + travelled, velocity, 120 - age);
+            AddEntity(bullet);
+            _Bullets.push_back(bullet);
+        }
+
+        OnUpdate.Bind(this, &ShooterScene::Fire);
+    }
+
+    void Fire(EventArgs &e) {
+        const auto &input = GetInput();
+        if (!input.Mouse.ButtonsDown[MOUSE_BUTTON_LEFT])
+            return;
+
+        auto aim = input.Mouse.Position - _PlayerPosition;
+        auto length = aim.Magnitude();
+        if (length > 0)
+            aim /= length;
+
+        // Reuse spent bullets, looking at a bounded number each tick
+        auto fired = 0;
+        for (auto i = 0; i < 1000 && fired < 100; i++) {
+            auto bullet = _Bullets[_NextBullet];
+            _NextBullet = (_NextBullet + 1) % _Bullets.size();
+
+            if (bullet->IsSpent()) {
+                auto spread = static_cast<float>(fired - 50) * 0.002f;
+                bullet->Fire(_PlayerPosition, {(aim.X - aim.Y * spread) * 8.0f, (aim.Y + aim.X * spread) * 8.0f}, 120);
+                fired++;
+            }
+        }
+    }
+};
+
+// Tile map scenario
+
+struct TAgentPosition {
+    int X;
+    int Y;
+};
+
+struct TAgentHeading {
+    int Direction;
+};
+
+class TileMapScene : public Scene {
+    static const int MapSize = 1024;
+    std::vector<unsigned char> _Tiles;
+public:
+    TileMapScene(Game *game_) : Scene(game_), _Tiles(MapSize * MapSize) {
+        std::mt19937 random(3);
+        std::uniform_int_distribution<int> tile(0, 4);
+        std::uniform_int_distribution<int> coordinate(0, MapSize - 1);
+
+        // One tile in five is a wall
+        for (auto &t : _Tiles) {
+            t = tile(random) == 0 ? 1 : 0;
+        }
+
+        for (auto i = 0; i < 5000; i++) {
+            auto agent = new BaseEntity(this, TVector2::Zero);
+            AddEntity(agent);
+
+            auto x = coordinate(random);
+            auto y = coordinate(random);
+            _Tiles[y * MapSize + x] = 0;
+            agent->AddComponent(TAgentPosition{x, y});
+            agent->AddComponent(TAgentHeading{i % 4});
+        }
+
+        // Agents walk forward and turn right at walls
+        AddSystem<TAgentPosition, TAgentHeading>([this](BaseEntity *, TAgentPosition &position_, TAgentHeading &heading_) {
+            static const int dx[4] = {1, 0, -1, 0};
+            static const int dy[4] = {0, 1, 0, -1};
+
+            for (auto attempt = 0; attempt < 4; attempt++) {
+                auto x = (position_.X + dx[heading_.Direction] + MapSize) % MapSize;
+                auto y = (position_.Y + dy[heading_.Direction] + MapSize) % MapSize;
+                if (_Tiles[y * MapSize + x] == 0) {
+                    position_.X = x;
+                    position_.Y = y;
+                    return;
+                }
+                heading_.Direction = (heading_.Direction + 1) % 4;
+            }
+        });
+    }
+};
+
+// UI scenario
+
+class StressControl : public UIControlSized {
+public:
+    StressControl(float width_, float height_) {
+        SetWidth(width_);
+        SetHeight(height_);
+    }
+};
+
+class WidgetEntity : public BaseEntity {
+    UIWidget _Widget;
+public:
+    int Hovered = 0;
+
+    WidgetEntity(Scene *scene_, TVector2 position_)
+        : BaseEntity(scene_, position_), _Widget(position_) {
+        _Widget.SetPanel(new VerticalPanel(120, 160));
+        for (auto i = 0; i < 5; i++) {
+            _Widget.GetPanel()->AddChild("control" + std::to_string(i), new StressControl(100, 24));
+        }
+        SubscribeToUpdate();
+    }
+
+    void Update(EventArgs &e) override {
+        BaseEntity::Update(e);
+        _Widget.Update();
+
+        // Hit test the children against the mouse, as a hover check would
+        auto mouse = GetParentScene()->GetInput().Mouse.Position;
+        for (auto child : _Widget.GetPanel()->GetChildren()) {
+            auto rect = child->GetRenderRectangle();
+            rect.X += _Widget.GetPosition().X;
+            rect.Y += _Widget.GetPosition().Y;
+            if (mouse.X >= rect.X && mouse.X < rect.X + rect.Width && mouse.Y >= rect.Y && mouse.Y < rect.Y + rect.Height)
+                Hovered++;
+        }
+    }
+};
+
+class UIScene : public Scene {
+public:
+    UIScene(Game *game_) : Scene(game_) {
+        // A 50 by 40 grid of widgets, overlapping the screen several times
+        for (auto i = 0; i < 2000; i++) {
+            AddEntity(new WidgetEntity(this, {static_cast<float>(i % 50) * 26.0f, static_cast<float>(i / 50) * 19.0f}));
+        }
+    }
+};
+
+// Harness
+
+/*
+ * The measurements of one scenario
+ */
+struct TStressResult {
+    /*
+     * Scenario name
+     */
+    std::string Name;
+
+    /*
+     * Measured ticks
+     */
+    unsigned int Ticks = 0;
+
+    /*
+     * Median tick time in milliseconds
+     */
+    double P50 = 0;
+
+    /*
+     * 99th percentile tick time in milliseconds
+     */
+    double P99 = 0;
+
+    /*
+     * Slowest tick time in milliseconds
+     */
+    double Max = 0;
+
+    /*
+     * Allocations per tick
+     */
+    double Allocations = 0;
+
+    /*
+     * Bytes allocated per tick
+     */
+    double AllocatedBytes = 0;
+
+    /*
+     * Process peak resident set size after the scenario, in kilobytes
+     */
+    std::uint64_t PeakRSS = 0;
+};
+
+/*
+ * A scenario
+ */
+struct TStressScenario {
+    /*
+     * Scenario name
+     */
+    std::string Name;
+
+    /*
+     * Create the scenario scene
+     */
+    std::function<Scene *(Game *)> Create;
+};
+
+/*
+ * Ticks run before measuring
+ */
+static const unsigned int WarmupTicks = 60;
+
+static TStressResult RunScenario(Game &game_, const TStressScenario &scenario_, unsigned int ticks_) {
+    std::cerr << "Running " << scenario_.Name << std::endl;
+
+    auto scene = scenario_.Create(&game_);
+    game_.SetScene(scene);
+
+    for (unsigned int i = 0; i < WarmupTicks; i++) {
+        scene->SetInput(MakeInput(i));
+        game_.RunTicks(1);
+    }
+
+    // Reserved up front so the harness does not allocate while measuring
+    std::vector<double> times;
+    times.reserve(ticks_);
+
+    auto allocations = AllocationCount.load();
+    auto bytes = AllocationBytes.load();
+
+    for (unsigned int i = 0; i < ticks_; i++) {
+        scene->SetInput(MakeInput(WarmupTicks + i));
+
+        auto start = std::chrono::steady_clock::now();
+        game_.RunTicks(1);
+        auto end = std::chrono::steady_clock::now();
+
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    allocations = AllocationCount.load() - allocations;
+    bytes = AllocationBytes.load() - bytes;
+
+    game_.SetScene(nullptr);
+    delete scene;
+
+    std::sort(times.begin(), times.end());
+
+    TStressResult result;
+    result.Name = scenario_.Name;
+    result.Ticks = ticks_;
+    result.P50 = times[times.size() / 2];
+    result.P99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    result.Max = times.back();
+    result.Allocations = static_cast<double>(allocations) / ticks_;
+    result.AllocatedBytes = static_cast<double>(bytes) / ticks_;
+    result.PeakRSS = GetPeakRSS();
+    return result;
+}
+
+int main(int argc, char **argv) {
+    // Usage: NgineStress [output.csv] [scenario] [ticks]
+    // Peak RSS is process wide, run one scenario per process for a clean figure.
+    auto outPath = argc > 1 ? std::string(argv[1]) : std::string("stress_results.csv");
+    auto only = argc > 2 ? std::string(argv[2]) : std::string("all");
+    auto ticks = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 600u;
+    if (ticks == 0)
+        ticks = 600;
+
+    std::vector<TStressScenario> scenarios = {
+        {"culled_entities_50k", [](Game *game_) -> Scene * { return new CullingScene(game_); }},
+        {"shooter_10k_bullets", [](Game *game_) -> Scene * { return new ShooterScene(game_); }},
+        {"tilemap_1024_agents", [](Game *game_) -> Scene * { return new TileMapScene(game_); }},
+        {"ui_2k_widgets", [](Game *game_) -> Scene * { return new UIScene(game_); }},
+    };
+
+    Game game(1280, 768, 60, "NgineStress", HEADLESS);
+
+    std::vector<TStressResult> results;
+    for (const auto &scenario : scenarios) {
+        if (only == "all" || only == scenario.Name)
+            results.push_back(RunScenario(game, scenario, ticks));
+    }
+
+    if (results.empty()) {
+        std::cerr << "Unknown scenario " << only << std::endl;
+        return 1;
+    }
+
+    std::ofstream file(outPath);
+    if (!file) {
+        std::cerr << "Failed to open " << outPath << std::endl;
+        return 1;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "scenario,ticks,p50_ms,p99_ms,max_ms,allocations_per_tick,bytes_per_tick,peak_rss_kb\n";
+    for (const auto &result : results) {
+        file << result.Name << "," << result.Ticks << "," << result.P50 << "," << result.P99 << "," << result.Max << ","
+             << result.Allocations << "," << result.AllocatedBytes << "," << result.PeakRSS << "\n";
+    }
+
+    std::cerr << "Results written to " << outPath << std::endl;
+    return 0;
+}
@@ -13,11 +13,19 @@
 
 #include "BaseEntity.h"
 
+#include <cmath>
+
 #include "Component.h"
 
 namespace NerdThings::Ngine {
     // Private Methods
 
+    Diagnostics::TTypeCost *BaseEntity::GetTypeCost() {
+        if (_TypeCost == nullptr)
+            _TypeCost = Diagnostics::CostTracker::GetTypeCost(typeid(*this), false);
+        return _TypeCost;
+    }
+
     void BaseEntity::RemoveEntityParent(BaseEntity *ent_) {
         ent_->_ParentEntity = nullptr;
     }
@@ -26,6 +34,33 @@ namespace NerdThings::Ngine {
         ent_->_ParentEntity = this;
     }
 
+    void BaseEntity::SnapshotTransform() {
+        auto update = _ParentScene->GetUpdateNumber();
+        if (_TransformSnapshot == update)
+            return;
+
+        _TransformSnapshot = update;
+        _InterpolationReset = false;
+        _PreviousPosition = _Position;
+        _PreviousRotation = _Rotation;
+    }
+
+    void BaseEntity::TransformChanged() {
+        // Keep the scene index up to date
+        _ParentScene->InternalUpdateEntityBounds(this);
+
+        if (_DeferTransformEvents) {
+            // Only queue once per update
+            if (!_TransformDirty) {
+                _TransformDirty = true;
+                _ParentScene->InternalQueueTransformChanged(this);
+            }
+            return;
+        }
+
+        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+    }
+
     // Public Constructor(s)
 
     BaseEntity::BaseEntity(Scene *parentScene_, const TVector2 position_, int depth_, bool canCull_)
@@ -33,6 +68,12 @@ namespace NerdThings::Ngine {
         if (parentScene_ == nullptr)
             throw std::runtime_error("Cannot give an entity a null parent scene.");
 
+        // Don't slide in from the constructor position if we are placed straight after
+        ResetInterpolation();
+
+        // Get a handle
+        _Handle = _ParentScene->InternalRegisterEntity(this);
+
         // Set initial depth
         _ParentScene->InternalSetEntityDepth(_Depth, this);
     }
@@ -46,8 +87,14 @@ namespace NerdThings::Ngine {
             delete comp.second;
         }
 
+        // Free our data components
+        _ParentScene->GetComponentStorage().RemoveAll(_ComponentLocation);
+
         // Unbind all events
         UnsubscribeFromUpdate();
+
+        // Invalidate our handle
+        _ParentScene->InternalReleaseEntity(_Handle);
     }
 
     // Public Methods
@@ -69,24 +116,64 @@ namespace NerdThings::Ngine {
         OnDraw({});
     }
 
+    TRectangle BaseEntity::GetBounds() const {
+        return {_Position, 0, 0};
+    }
+
     bool BaseEntity::GetCanCull() {
         return _CanCull;
     }
 
     std::vector<Component *> BaseEntity::GetComponents() {
         std::vector<Component*> vec;
+        vec.reserve(_Components.size());
 
-        for (auto it = _Components.begin(); it != _Components.end(); ++it) {
-            vec.push_back(it->second);
+        for (const auto &pair : _Components) {
+            vec.push_back(pair.second);
         }
 
         return vec;
     }
 
+    bool BaseEntity::GetDeferTransformEvents() const {
+        return _DeferTransformEvents;
+    }
+
     int BaseEntity::GetDepth() const {
         return _Depth;
     }
 
+    TVector2 BaseEntity::GetDrawPosition() const {
+        // Not moved by the last update
+        if (_TransformSnapshot != _ParentScene->GetUpdateNumber() || _InterpolationReset)
+            return _Position;
+
+        auto alpha = _ParentScene->GetInterpolationAlpha();
+        return {_PreviousPosition.X + (_Position.X - _PreviousPosition.X) * alpha,
+                _PreviousPosition.Y + (_Position.Y - _PreviousPosition.Y) * alpha};
+    }
+
+    float BaseEntity::GetDrawRotation() const {
+        if (_TransformSnapshot != _ParentScene->GetUpdateNumber() || _InterpolationReset)
+            return _Rotation;
+
+        // Take the short way round
+        auto difference = std::remainder(_Rotation - _PreviousRotation, 6.28318530718f);
+        return _Rotation - difference * (1.0f - _ParentScene->GetInterpolationAlpha());
+    }
+
+    bool BaseEntity::GetDrawWithCamera() const {
+        return _DrawWithCamera;
+    }
+
+    EntityHandle BaseEntity::GetHandle() const {
+        return _Handle;
+    }
+
+    const std::string &BaseEntity::GetName() const {
+        return _Name;
+    }
+
     TVector2 BaseEntity::GetOrigin() const {
         return _Origin;
     }
@@ -124,30 +211,95 @@ namespace NerdThings::Ngine {
     // }
 
     bool BaseEntity::HasComponent(const std::string &name_) {
-        return _Components.find(name_) != _Components.end();
+        for (const auto &pair : _Components) {
+            if (pair.first == name_)
+                return true;
+        }
+        return false;
+    }
+
+    void BaseEntity::InternalDraw() {
+#if defined(NGINE_PROFILER)
+        if (Diagnostics::CostTracker::IsEnabled()) {
+            Diagnostics::CostScope scope(GetTypeCost(), Diagnostics::COST_DRAW);
+            Draw();
+            return;
+        }
+#endif
+        Draw();
+    }
+
+    void BaseEntity::InternalFlushTransformChanged() {
+        if (!_TransformDirty)
+            return;
+
+        _TransformDirty = false;
+        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+    }
+
+    unsigned int BaseEntity::InternalGetContainerIndex() const {
+        return _ContainerIndex;
+    }
+
+    void BaseEntity::InternalSetContainerIndex(unsigned int index_) {
+        _ContainerIndex = index_;
+    }
+
+    void BaseEntity::InternalSetName(const std::string &name_) {
+        _Name = name_;
+    }
+
+    void BaseEntity::InternalUpdate(EventArgs &e) {
+#if defined(NGINE_PROFILER)
+        if (Diagnostics::CostTracker::IsEnabled()) {
+            // The scope only holds the counters, so we can be destroyed during the update
+            Diagnostics::CostScope scope(GetTypeCost(), Diagnostics::COST_UPDATE);
+            Update(e);
+            return;
+        }
+#endif
+        Update(e);
     }
 
     void BaseEntity::MoveBy(const TVector2 moveBy_) {
+        SnapshotTransform();
         _Position += moveBy_;
-        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+        TransformChanged();
     }
 
     bool BaseEntity::RemoveComponent(const std::string &name_) {
-        const auto comp = GetComponent<Component>(name_);
-
-        if (comp != nullptr) {
-            // Remove component from map
-            _Components.erase(name_);
+        for (auto it = _Components.begin(); it != _Components.end(); ++it) {
+            if (it->first == name_) {
+                // Remove component from list
+                _Components.erase(it);
 
-            return true;
+                return true;
+            }
         }
 
         // We don't have this component
         return false;
     }
 
+    void BaseEntity::ResetInterpolation() {
+        _TransformSnapshot = _ParentScene->GetUpdateNumber();
+        _InterpolationReset = true;
+    }
+
     void BaseEntity::SetCanCull(bool canCull_) {
         _CanCull = canCull_;
+
+        // Make sure the next cull pass looks at us
+        if (_CanCull)
+            _ParentScene->InternalQueueEntityCull(this);
+    }
+
+    void BaseEntity::SetDeferTransformEvents(bool defer_) {
+        _DeferTransformEvents = defer_;
+
+        // Don't leave listeners waiting
+        if (!_DeferTransformEvents)
+            InternalFlushTransformChanged();
     }
 
     void BaseEntity::SetDepth(int depth_) {
@@ -155,9 +307,14 @@ namespace NerdThings::Ngine {
         _Depth = depth_;
     }
 
+    void BaseEntity::SetDrawWithCamera(bool drawWithCamera_) {
+        _ParentScene->InternalUpdateEntityDrawWithCamera(drawWithCamera_, this);
+        _DrawWithCamera = drawWithCamera_;
+    }
+
     void BaseEntity::SetOrigin(TVector2 origin_) {
         _Origin = origin_;
-        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+        TransformChanged();
     }
 
     void BaseEntity::SetDoPersistentUpdates(bool persistentUpdates_) {
@@ -167,13 +324,15 @@ namespace NerdThings::Ngine {
     }
 
     void BaseEntity::SetPosition(const TVector2 position_) {
+        SnapshotTransform();
         _Position = position_;
-        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+        TransformChanged();
     }
 
     void BaseEntity::SetRotation(float rotation_) {
+        SnapshotTransform();
         _Rotation = rotation_;
-        OnTransformChanged({_Origin, _Position, _Rotation, 1});
+        TransformChanged();
     }
 
     // void BaseEntity::SetScale(float scale_) {
@@ -184,8 +343,8 @@ namespace NerdThings::Ngine {
     bool BaseEntity::SubscribeToUpdate() {
         if (_ParentScene != nullptr) {
             if (_OnUpdateRef.ID < 0) {
-                if (_PersistentUpdates) _OnUpdateRef = _ParentScene->OnPersistentUpdate.Bind<BaseEntity>(this, &BaseEntity::Update);
-                else _OnUpdateRef = _ParentScene->OnUpdate.Bind<BaseEntity>(this, &BaseEntity::Update);
+                if (_PersistentUpdates) _OnUpdateRef = _ParentScene->OnPersistentUpdate.Bind<BaseEntity>(this, &BaseEntity::InternalUpdate);
+                else _OnUpdateRef = _ParentScene->OnUpdate.Bind<BaseEntity>(this, &BaseEntity::InternalUpdate);
                 return true;
             } else {
                 // We still have an event, soooo...
@@ -20,6 +20,8 @@
 #include "ngine.h"
 
 #include "Vector2.h"
+#include "ComponentStorage.h"
+#include "Diagnostics/CostTracker.h"
 #include "EventArgs.h"
 #include "EntityContainer.h"
 #include "Scene.h"
@@ -38,17 +40,49 @@ namespace NerdThings::Ngine {
          */
         bool _CanCull = false;
 
+        /*
+         * Where our data components live in the scene storage
+         */
+        TComponentLocation _ComponentLocation;
+
         /*
          * The list of all components.
          * All components are given a name for easy identification.
+         * This is kept flat as entities rarely have more than a handful.
+         */
+        std::vector<std::pair<std::string, Component*>> _Components;
+
+        /*
+         * Our index in the parent container
          */
-        std::map<std::string, Component*> _Components;
+        unsigned int _ContainerIndex = 0;
+
+        /*
+         * Whether or not transform events are deferred to the end of the scene update
+         */
+        bool _DeferTransformEvents = false;
 
         /*
          * Depth layer
          */
         int _Depth;
 
+        /*
+         * Whether or not this entity is drawn with the camera
+         */
+        bool _DrawWithCamera = true;
+
+        /*
+         * Our handle in the parent scene
+         */
+        EntityHandle _Handle;
+
+        /*
+         * The name given when added to a container.
+         * Empty if unnamed.
+         */
+        std::string _Name;
+
         /*
          * On update event reference
          */
@@ -69,6 +103,11 @@ namespace NerdThings::Ngine {
          */
         Scene *_ParentScene = nullptr;
 
+        /*
+         * Whether or not interpolation was reset since the last update
+         */
+        bool _InterpolationReset = false;
+
         /*
          * Whether or not we update when paused
          */
@@ -79,11 +118,36 @@ namespace NerdThings::Ngine {
          */
         TVector2 _Position = TVector2::Zero;
 
+        /*
+         * The entity position before the last update that moved it
+         */
+        TVector2 _PreviousPosition = TVector2::Zero;
+
+        /*
+         * The entity rotation before the last update that rotated it
+         */
+        float _PreviousRotation = 0;
+
         /*
          * The entity rotation (in radians)
          */
         float _Rotation = 0;
 
+        /*
+         * Whether or not a deferred transform event is waiting to fire
+         */
+        bool _TransformDirty = false;
+
+        /*
+         * The scene update our previous transform was saved in
+         */
+        std::uint64_t _TransformSnapshot = 0;
+
+        /*
+         * Cost counters for our type, fetched on first use
+         */
+        Diagnostics::TTypeCost *_TypeCost = nullptr;
+
         // TODO: Add logic and draw scaling
         // /*
         //  * The entity scale (Used for rendering and physics)
@@ -92,16 +156,26 @@ namespace NerdThings::Ngine {
 
         // Private Methods
 
+        /*
+         * Get the cost counters for our type
+         */
+        Diagnostics::TTypeCost *GetTypeCost();
+
         void RemoveEntityParent(BaseEntity *ent_) override;
 
         void SetEntityParent(BaseEntity *ent_) override;
-    public:
-        // Public Fields
 
         /*
-         * Whether or not this entity is drawn with the camera
+         * Save the transform before its first change in a scene update, for interpolation
          */
-        bool DrawWithCamera = true;
+        void SnapshotTransform();
+
+        /*
+         * Notify the scene and fire (or defer) the transform changed event
+         */
+        void TransformChanged();
+    public:
+        // Public Fields
 
         /*
          * On draw event
@@ -146,16 +220,30 @@ namespace NerdThings::Ngine {
             auto comp = dynamic_cast<Component*>(component_);
 
             if (comp != nullptr) {
-                _Components.insert({name_, comp});
+                _Components.push_back({name_, comp});
                 return component_;
             }
 
             return nullptr;
         }
 
+        /*
+         * Add a data component to the entity.
+         * Data components are plain values stored contiguously in the scene's component storage.
+         * The returned pointer is only valid until the next time any entity in the scene gains or loses a data component.
+         */
+        template <typename ComponentType>
+        ComponentType *AddComponent(ComponentType component_) {
+            static_assert(!std::is_pointer<ComponentType>::value, "Use the named overload for Component pointers.");
+            static_assert(!std::is_base_of<Component, ComponentType>::value, "Component classes must be added by name.");
+
+            return _ParentScene->GetComponentStorage().Add<ComponentType>(this, _ComponentLocation, std::move(component_));
+        }
+
         /*
          * This is used to determine if this entity should be culled.
          * This can allow you to hide this if the collision box is not contained instead.
+         * The scene only asks entities whose bounds are near the cull area, so GetBounds must cover what this checks.
          */
         virtual bool CheckForCulling(TRectangle cullArea_);
 
@@ -176,13 +264,30 @@ namespace NerdThings::Ngine {
         template <typename ComponentType>
         ComponentType *GetComponent(const std::string &name_) {
             // Try to find the component
-            if (HasComponent(name_)) {
-                return dynamic_cast<ComponentType*>(_Components.at(name_)); // Will return null if its the wrong type
+            for (const auto &pair : _Components) {
+                if (pair.first == name_)
+                    return dynamic_cast<ComponentType*>(pair.second); // Will return null if its the wrong type
             }
 
             return nullptr;
         }
 
+        /*
+         * Get a data component.
+         * Returns null if we do not have one of this type.
+         */
+        template <typename ComponentType>
+        ComponentType *GetComponent() const {
+            return _ParentScene->GetComponentStorage().Get<ComponentType>(_ComponentLocation);
+        }
+
+        /*
+         * Get the entity bounds, used by the scene spatial index.
+         * By default this is just the position.
+         * If overridden, call Scene::InternalUpdateEntityBounds when the bounds change outside of a transform change.
+         */
+        [[nodiscard]] virtual TRectangle GetBounds() const;
+
         /*
          * Check if this entity can be culled
          */
@@ -198,6 +303,40 @@ namespace NerdThings::Ngine {
          */
         int GetDepth() const;
 
+        /*
+         * Get whether or not transform events are deferred
+         */
+        [[nodiscard]] bool GetDeferTransformEvents() const;
+
+        /*
+         * Get the position to draw at.
+         * When interpolating, this is between the position before and after the last update.
+         */
+        [[nodiscard]] TVector2 GetDrawPosition() const;
+
+        /*
+         * Get the rotation to draw at.
+         * When interpolating, this is between the rotation before and after the last update.
+         */
+        [[nodiscard]] float GetDrawRotation() const;
+
+        /*
+         * Get whether or not this entity is drawn with the camera
+         */
+        [[nodiscard]] bool GetDrawWithCamera() const;
+
+        /*
+         * Get our handle.
+         * Handles stay safe to resolve after the entity is destroyed.
+         */
+        [[nodiscard]] EntityHandle GetHandle() const;
+
+        /*
+         * Get the name given by the parent container.
+         * Empty if unnamed.
+         */
+        [[nodiscard]] const std::string &GetName() const;
+
         /*
          * Get entity origin
          */
@@ -253,6 +392,44 @@ namespace NerdThings::Ngine {
          */
         bool HasComponent(const std::string &name_);
 
+        /*
+         * Test if we have a data component of a type.
+         */
+        template <typename ComponentType>
+        bool HasComponent() const {
+            return _ParentScene->GetComponentStorage().Has<ComponentType>(_ComponentLocation);
+        }
+
+        /*
+         * Draw, timing the call if cost tracking is on (internally used)
+         */
+        void InternalDraw();
+
+        /*
+         * Fire a deferred transform changed event, if one is waiting (internally used)
+         */
+        void InternalFlushTransformChanged();
+
+        /*
+         * Get our index in the parent container (internally used)
+         */
+        [[nodiscard]] unsigned int InternalGetContainerIndex() const;
+
+        /*
+         * Set our index in the parent container (internally used)
+         */
+        void InternalSetContainerIndex(unsigned int index_);
+
+        /*
+         * Set our name (internally used)
+         */
+        void InternalSetName(const std::string &name_);
+
+        /*
+         * Update, timing the call if cost tracking is on (internally used)
+         */
+        void InternalUpdate(EventArgs &e);
+
         /*
          * Move an entity
          */
@@ -264,16 +441,44 @@ namespace NerdThings::Ngine {
          */
         bool RemoveComponent(const std::string &name_);
 
+        /*
+         * Remove a data component.
+         * Returns success or fail.
+         */
+        template <typename ComponentType>
+        bool RemoveComponent() {
+            return _ParentScene->GetComponentStorage().Remove<ComponentType>(this, _ComponentLocation);
+        }
+
+        /*
+         * Draw at the current transform until the next update.
+         * Use after teleporting, so we are not drawn sliding across the scene.
+         */
+        void ResetInterpolation();
+
         /*
          * Set whether or not this entity can be culled
          */
         void SetCanCull(bool canCull_);
 
+        /*
+         * Set whether or not transform events are deferred.
+         * When deferred, OnTransformChanged fires once per scene update at most, after the update handlers,
+         * no matter how many times the transform was changed.
+         * Collision shapes and other listeners are stale until then.
+         */
+        void SetDeferTransformEvents(bool defer_);
+
         /*
          * Set the entity depth
          */
         void SetDepth(int depth_);
 
+        /*
+         * Set whether or not this entity is drawn with the camera
+         */
+        void SetDrawWithCamera(bool drawWithCamera_);
+
         /*
          * Set entity origin
          */
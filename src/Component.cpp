@@ -14,6 +14,36 @@
 #include "BaseEntity.h"
 
 namespace NerdThings::Ngine {
+    // Private Methods
+
+    Diagnostics::TTypeCost *Component::GetTypeCost() {
+        if (_TypeCost == nullptr)
+            _TypeCost = Diagnostics::CostTracker::GetTypeCost(typeid(*this), true);
+        return _TypeCost;
+    }
+
+    void Component::InternalDraw(EventArgs &e) {
+#if defined(NGINE_PROFILER)
+        if (Diagnostics::CostTracker::IsEnabled()) {
+            Diagnostics::CostScope scope(GetTypeCost(), Diagnostics::COST_DRAW);
+            Draw(e);
+            return;
+        }
+#endif
+        Draw(e);
+    }
+
+    void Component::InternalUpdate(EventArgs &e) {
+#if defined(NGINE_PROFILER)
+        if (Diagnostics::CostTracker::IsEnabled()) {
+            Diagnostics::CostScope scope(GetTypeCost(), Diagnostics::COST_UPDATE);
+            Update(e);
+            return;
+        }
+#endif
+        Update(e);
+    }
+
     // Public Methods
 
     void Component::Draw(EventArgs &e) { }
@@ -24,7 +54,7 @@ namespace NerdThings::Ngine {
 
     void Component::SubscribeToDraw() {
         if (HasParent()) {
-            _OnDrawRef = _ParentEntity->OnDraw.Bind(this, &Component::Draw);
+            _OnDrawRef = _ParentEntity->OnDraw.Bind(this, &Component::InternalDraw);
         }
     }
 
@@ -33,7 +63,7 @@ namespace NerdThings::Ngine {
             // Check the entity subscribed to update
             // If not, subscribe
             if (_ParentEntity->SubscribeToUpdate()) {
-                _OnUpdateRef = _ParentEntity->OnUpdate.Bind(this, &Component::Update);
+                _OnUpdateRef = _ParentEntity->OnUpdate.Bind(this, &Component::InternalUpdate);
             }
         }
     }
@@ -14,6 +14,7 @@
 
 #include "ngine.h"
 
+#include "Diagnostics/CostTracker.h"
 #include "EventHandler.h"
 
 namespace NerdThings::Ngine {
@@ -41,6 +42,28 @@ namespace NerdThings::Ngine {
          * The parent entity
          */
         BaseEntity *_ParentEntity = nullptr;
+
+        /*
+         * Cost counters for our type, fetched on first use
+         */
+        Diagnostics::TTypeCost *_TypeCost = nullptr;
+
+        // Private Methods
+
+        /*
+         * Get the cost counters for our type
+         */
+        Diagnostics::TTypeCost *GetTypeCost();
+
+        /*
+         * Draw, timing the call if cost tracking is on
+         */
+        void InternalDraw(EventArgs &e);
+
+        /*
+         * Update, timing the call if cost tracking is on
+         */
+        void InternalUpdate(EventArgs &e);
     public:
         // Public Fields
 
@@ -0,0 +1,356 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "ComponentStorage.h"
+
+namespace NerdThings::Ngine {
+    ////////
+    // ComponentColumn
+    ////////
+
+    // Private Constructor(s)
+
+    ComponentColumn::ComponentColumn(unsigned int type_, size_t elementSize_, size_t alignment_,
+                                     void (*moveConstruct_)(void *, void *), void (*destruct_)(void *))
+        : _Alignment(alignment_), _Destruct(destruct_), _ElementSize(elementSize_),
+          _MoveConstruct(moveConstruct_), _Type(type_) {}
+
+    // Public Constructor(s)
+
+    ComponentColumn::ComponentColumn(ComponentColumn &&column_) noexcept
+        : _Alignment(column_._Alignment), _Capacity(column_._Capacity), _Data(column_._Data),
+          _Destruct(column_._Destruct), _ElementSize(column_._ElementSize),
+          _MoveConstruct(column_._MoveConstruct), _Type(column_._Type) {
+        column_._Data = nullptr;
+        column_._Capacity = 0;
+    }
+
+    // Destructor
+
+    ComponentColumn::~ComponentColumn() {
+        // Elements are destroyed by the archetype, we only own the memory
+        if (_Data != nullptr)
+            ::operator delete(_Data, std::align_val_t(_Alignment));
+    }
+
+    // Public Methods
+
+    ComponentColumn ComponentColumn::CreateEmpty() const {
+        return ComponentColumn(_Type, _ElementSize, _Alignment, _MoveConstruct, _Destruct);
+    }
+
+    void ComponentColumn::Destroy(size_t index_) {
+        _Destruct(At(index_));
+    }
+
+    unsigned int ComponentColumn::GetType() const {
+        return _Type;
+    }
+
+    void ComponentColumn::MoveConstruct(size_t index_, void *src_) {
+        _MoveConstruct(At(index_), src_);
+    }
+
+    void ComponentColumn::Reserve(size_t capacity_, size_t count_) {
+        if (capacity_ <= _Capacity) return;
+
+        auto data = static_cast<unsigned char *>(::operator new(capacity_ * _ElementSize, std::align_val_t(_Alignment)));
+
+        // Move live elements across
+        for (size_t i = 0; i < count_; i++) {
+            auto src = At(i);
+            _MoveConstruct(data + i * _ElementSize, src);
+            _Destruct(src);
+        }
+
+        if (_Data != nullptr)
+            ::operator delete(_Data, std::align_val_t(_Alignment));
+
+        _Data = data;
+        _Capacity = capacity_;
+    }
+
+    // Operators
+
+    ComponentColumn &ComponentColumn::operator=(ComponentColumn &&column_) noexcept {
+        if (this == &column_) return *this;
+
+        if (_Data != nullptr)
+            ::operator delete(_Data, std::align_val_t(_Alignment));
+
+        _Alignment = column_._Alignment;
+        _Capacity = column_._Capacity;
+        _Data = column_._Data;
+        _Destruct = column_._Destruct;
+        _ElementSize = column_._ElementSize;
+        _MoveConstruct = column_._MoveConstruct;
+        _Type = column_._Type;
+
+        column_._Data = nullptr;
+        column_._Capacity = 0;
+        return *this;
+    }
+
+    ////////
+    // ComponentArchetype
+    ////////
+
+    // Public Constructor(s)
+
+    ComponentArchetype::ComponentArchetype(std::vector<unsigned int> signature_, std::vector<ComponentColumn> columns_)
+        : _Columns(std::move(columns_)), _Signature(std::move(signature_)) {}
+
+    // Destructor
+
+    ComponentArchetype::~ComponentArchetype() {
+        // Destroy any rows still alive
+        for (auto &col : _Columns) {
+            for (size_t i = 0; i < _Entities.size(); i++) {
+                col.Destroy(i);
+            }
+        }
+
+        // Detach anything still pointing at us
+        for (auto loc : _Locations) {
+            loc->Archetype = nullptr;
+            loc->Row = 0;
+        }
+    }
+
+    // Public Methods
+
+    unsigned int ComponentArchetype::AllocateRow(BaseEntity *entity_, TComponentLocation *location_) {
+        auto row = _Entities.size();
+
+        // Grow columns geometrically
+        if (row >= _Capacity) {
+            auto capacity = _Capacity == 0 ? 16 : _Capacity * 2;
+            for (auto &col : _Columns) {
+                col.Reserve(capacity, row);
+            }
+            _Capacity = capacity;
+        }
+
+        _Entities.push_back(entity_);
+        _Locations.push_back(location_);
+
+        return static_cast<unsigned int>(row);
+    }
+
+    ComponentColumn *ComponentArchetype::GetColumn(unsigned int type_) {
+        auto index = GetColumnIndex(type_);
+        if (index < 0) return nullptr;
+        return &_Columns[index];
+    }
+
+    int ComponentArchetype::GetColumnIndex(unsigned int type_) const {
+        // Signatures are small, a linear scan beats a search
+        for (size_t i = 0; i < _Signature.size(); i++) {
+            if (_Signature[i] == type_) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    std::vector<ComponentColumn> &ComponentArchetype::GetColumns() {
+        return _Columns;
+    }
+
+    size_t ComponentArchetype::GetCount() const {
+        return _Entities.size();
+    }
+
+    const std::vector<BaseEntity *> &ComponentArchetype::GetEntities() const {
+        return _Entities;
+    }
+
+    const std::vector<unsigned int> &ComponentArchetype::GetSignature() const {
+        return _Signature;
+    }
+
+    bool ComponentArchetype::HasType(unsigned int type_) const {
+        return GetColumnIndex(type_) >= 0;
+    }
+
+    void ComponentArchetype::RemoveRow(unsigned int row_) {
+        auto last = static_cast<unsigned int>(_Entities.size() - 1);
+
+        for (auto &col : _Columns) {
+            col.Destroy(row_);
+
+            // Fill the gap with the last row
+            if (row_ != last) {
+                col.MoveConstruct(row_, col.At(last));
+                col.Destroy(last);
+            }
+        }
+
+        if (row_ != last) {
+            _Entities[row_] = _Entities[last];
+            _Locations[row_] = _Locations[last];
+            _Locations[row_]->Row = row_;
+        }
+
+        _Entities.pop_back();
+        _Locations.pop_back();
+    }
+
+    ////////
+    // ComponentStorage
+    ////////
+
+    // Private Methods
+
+    void ComponentStorage::CheckUnlocked() const {
+        if (_Locked) {
+            ConsoleMessage("Data components cannot be added or removed while systems are running.", "FATAL", "COMPONENTSTORAGE");
+            throw std::runtime_error("Component storage is locked.");
+        }
+    }
+
+    ComponentArchetype *ComponentStorage::GetAddTarget(ComponentArchetype *archetype_, unsigned int type_,
+                                                       ComponentColumn (*createColumn_)()) {
+        // Check the edge cache
+        if (archetype_ != nullptr) {
+            auto edge = archetype_->AddEdges.find(type_);
+            if (edge != archetype_->AddEdges.end())
+                return edge->second;
+        }
+
+        // Build the new signature, keeping it sorted
+        std::vector<unsigned int> signature;
+        if (archetype_ != nullptr) signature = archetype_->GetSignature();
+        signature.insert(std::upper_bound(signature.begin(), signature.end(), type_), type_);
+
+        // Build matching columns
+        std::vector<ComponentColumn> columns;
+        columns.reserve(signature.size());
+        for (auto type : signature) {
+            if (type == type_) columns.push_back(createColumn_());
+            else columns.push_back(archetype_->GetColumn(type)->CreateEmpty());
+        }
+
+        auto target = GetArchetype(signature, std::move(columns));
+
+        // Cache edges both ways
+        if (archetype_ != nullptr) {
+            archetype_->AddEdges.insert({type_, target});
+            target->RemoveEdges.insert({type_, archetype_});
+        }
+
+        return target;
+    }
+
+    ComponentArchetype *ComponentStorage::GetArchetype(const std::vector<unsigned int> &signature_,
+                                                       std::vector<ComponentColumn> columns_) {
+        auto existing = _ArchetypeLookup.find(signature_);
+        if (existing != _ArchetypeLookup.end())
+            return existing->second;
+
+        _Archetypes.push_back(std::make_unique<ComponentArchetype>(signature_, std::move(columns_)));
+        auto archetype = _Archetypes.back().get();
+        _ArchetypeLookup.insert({signature_, archetype});
+        return archetype;
+    }
+
+    ComponentArchetype *ComponentStorage::GetRemoveTarget(ComponentArchetype *archetype_, unsigned int type_) {
+        // Check the edge cache
+        auto edge = archetype_->RemoveEdges.find(type_);
+        if (edge != archetype_->RemoveEdges.end())
+            return edge->second;
+
+        // Build the new signature
+        auto signature = archetype_->GetSignature();
+        signature.erase(std::find(signature.begin(), signature.end(), type_));
+
+        if (signature.empty())
+            return nullptr;
+
+        std::vector<ComponentColumn> columns;
+        columns.reserve(signature.size());
+        for (auto type : signature) {
+            columns.push_back(archetype_->GetColumn(type)->CreateEmpty());
+        }
+
+        auto target = GetArchetype(signature, std::move(columns));
+
+        // Cache edges both ways
+        archetype_->RemoveEdges.insert({type_, target});
+        target->AddEdges.insert({type_, archetype_});
+
+        return target;
+    }
+
+    unsigned int ComponentStorage::MoveEntity(BaseEntity *entity_, TComponentLocation &location_,
+                                              ComponentArchetype *target_) {
+        auto source = location_.Archetype;
+        auto row = target_->AllocateRow(entity_, &location_);
+
+        if (source != nullptr) {
+            auto oldRow = location_.Row;
+
+            // Move the shared components across
+            for (auto &col : source->GetColumns()) {
+                auto dst = target_->GetColumn(col.GetType());
+                if (dst != nullptr) dst->MoveConstruct(row, col.At(oldRow));
+            }
+
+            // Free the old row. This destroys the moved-from elements
+            source->RemoveRow(oldRow);
+        }
+
+        location_.Archetype = target_;
+        location_.Row = row;
+
+        return row;
+    }
+
+    // Public Methods
+
+    const std::vector<std::unique_ptr<ComponentArchetype>> &ComponentStorage::GetArchetypes() const {
+        return _Archetypes;
+    }
+
+    bool ComponentStorage::IsLocked() const {
+        return _Locked;
+    }
+
+    bool ComponentStorage::Remove(BaseEntity *entity_, TComponentLocation &location_, unsigned int type_) {
+        auto source = location_.Archetype;
+        if (source == nullptr || !source->HasType(type_))
+            return false;
+
+        CheckUnlocked();
+
+        auto target = GetRemoveTarget(source, type_);
+
+        // Nothing left, drop the row entirely
+        if (target == nullptr) {
+            RemoveAll(location_);
+            return true;
+        }
+
+        MoveEntity(entity_, location_, target);
+        return true;
+    }
+
+    void ComponentStorage::RemoveAll(TComponentLocation &location_) {
+        if (location_.Archetype == nullptr) return;
+
+        CheckUnlocked();
+        location_.Archetype->RemoveRow(location_.Row);
+        location_.Archetype = nullptr;
+        location_.Row = 0;
+    }
+
+    void ComponentStorage::SetLocked(bool locked_) {
+        _Locked = locked_;
+    }
+}
@@ -0,0 +1,487 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef COMPONENTSTORAGE_H
+#define COMPONENTSTORAGE_H
+
+#include "ngine.h"
+
+#include <new>
+
+#include "TypeID.h"
+
+namespace NerdThings::Ngine {
+    // We do this forward declaration instead of include because BaseEntity uses this.
+    class NEAPI BaseEntity;
+    class NEAPI ComponentArchetype;
+
+    /*
+     * Where an entity's data components live.
+     * This is owned by the entity and updated by the storage whenever rows move.
+     */
+    struct TComponentLocation {
+        // Public Fields
+
+        /*
+         * The archetype holding the entity's data components.
+         * Null if the entity has no data components.
+         */
+        ComponentArchetype *Archetype = nullptr;
+
+        /*
+         * The row within the archetype
+         */
+        unsigned int Row = 0;
+    };
+
+    /*
+     * A dense, type-erased array of a single data component type.
+     */
+    class NEAPI ComponentColumn {
+        // Private Fields
+
+        /*
+         * Alignment of a single element
+         */
+        size_t _Alignment = 0;
+
+        /*
+         * Number of elements we have room for
+         */
+        size_t _Capacity = 0;
+
+        /*
+         * The raw element memory
+         */
+        unsigned char *_Data = nullptr;
+
+        /*
+         * Destroy an element
+         */
+        void (*_Destruct)(void *ptr_) = nullptr;
+
+        /*
+         * Size of a single element
+         */
+        size_t _ElementSize = 0;
+
+        /*
+         * Move construct an element from another
+         */
+        void (*_MoveConstruct)(void *dst_, void *src_) = nullptr;
+
+        /*
+         * The component type ID stored
+         */
+        unsigned int _Type;
+
+        // Private Constructor(s)
+
+        ComponentColumn(unsigned int type_, size_t elementSize_, size_t alignment_,
+                        void (*moveConstruct_)(void *, void *), void (*destruct_)(void *));
+    public:
+        // Public Constructor(s)
+
+        ComponentColumn(ComponentColumn &&column_) noexcept;
+
+        ComponentColumn(const ComponentColumn &column_) = delete;
+
+        // Destructor
+
+        ~ComponentColumn();
+
+        // Public Methods
+
+        /*
+         * Get a pointer to an element
+         */
+        void *At(size_t index_) const {
+            return _Data + index_ * _ElementSize;
+        }
+
+        /*
+         * Create an empty column for a component type
+         */
+        template <typename ComponentType>
+        static ComponentColumn Create() {
+            static_assert(!std::is_pointer<ComponentType>::value, "Data components must be stored by value.");
+            static_assert(std::is_move_constructible<ComponentType>::value, "Data components must be movable.");
+
+            return ComponentColumn(TypeID::Get<ComponentType>(), sizeof(ComponentType), alignof(ComponentType),
+                                   [](void *dst_, void *src_) {
+                                       new (dst_) ComponentType(std::move(*static_cast<ComponentType *>(src_)));
+                                   },
+                                   [](void *ptr_) {
+                                       static_cast<ComponentType *>(ptr_)->~ComponentType();
+                                   });
+        }
+
+        /*
+         * Create an empty column storing the same type as this one
+         */
+        [[nodiscard]] ComponentColumn CreateEmpty() const;
+
+        /*
+         * Destroy the element at an index
+         */
+        void Destroy(size_t index_);
+
+        /*
+         * Get the component type ID stored
+         */
+        [[nodiscard]] unsigned int GetType() const;
+
+        /*
+         * Move construct into an empty slot from another element
+         */
+        void MoveConstruct(size_t index_, void *src_);
+
+        /*
+         * Grow the column so that it can fit capacity_ elements.
+         * count_ is the number of live elements that must be moved.
+         */
+        void Reserve(size_t capacity_, size_t count_);
+
+        // Operators
+
+        ComponentColumn &operator=(ComponentColumn &&column_) noexcept;
+
+        ComponentColumn &operator=(const ComponentColumn &column_) = delete;
+    };
+
+    /*
+     * A table of entities that all have exactly the same set of data components.
+     * Every component type gets its own dense column, indexed by row.
+     */
+    class NEAPI ComponentArchetype {
+        // Private Fields
+
+        /*
+         * Row capacity of every column
+         */
+        size_t _Capacity = 0;
+
+        /*
+         * The component columns, parallel to the signature
+         */
+        std::vector<ComponentColumn> _Columns;
+
+        /*
+         * The entity owning each row
+         */
+        std::vector<BaseEntity *> _Entities;
+
+        /*
+         * The location record owning each row
+         */
+        std::vector<TComponentLocation *> _Locations;
+
+        /*
+         * Sorted list of component type IDs held
+         */
+        std::vector<unsigned int> _Signature;
+    public:
+        // Public Fields
+
+        /*
+         * Archetype reached by adding a component type to this one.
+         */
+        std::unordered_map<unsigned int, ComponentArchetype *> AddEdges;
+
+        /*
+         * Archetype reached by removing a component type from this one.
+         */
+        std::unordered_map<unsigned int, ComponentArchetype *> RemoveEdges;
+
+        // Public Constructor(s)
+
+        /*
+         * Create an archetype from a sorted signature and matching empty columns
+         */
+        ComponentArchetype(std::vector<unsigned int> signature_, std::vector<ComponentColumn> columns_);
+
+        ComponentArchetype(const ComponentArchetype &archetype_) = delete;
+
+        // Destructor
+
+        ~ComponentArchetype();
+
+        // Public Methods
+
+        /*
+         * Append a row.
+         * The component elements of the new row are left unconstructed.
+         */
+        unsigned int AllocateRow(BaseEntity *entity_, TComponentLocation *location_);
+
+        /*
+         * Get the column for a type, or null if we do not hold it
+         */
+        ComponentColumn *GetColumn(unsigned int type_);
+
+        /*
+         * Get the column index for a type, or -1 if we do not hold it
+         */
+        [[nodiscard]] int GetColumnIndex(unsigned int type_) const;
+
+        /*
+         * Get all columns
+         */
+        std::vector<ComponentColumn> &GetColumns();
+
+        /*
+         * Get the number of rows
+         */
+        [[nodiscard]] size_t GetCount() const;
+
+        /*
+         * Get the entity owning each row
+         */
+        [[nodiscard]] const std::vector<BaseEntity *> &GetEntities() const;
+
+        /*
+         * Get the sorted component signature
+         */
+        [[nodiscard]] const std::vector<unsigned int> &GetSignature() const;
+
+        /*
+         * Whether or not we hold a component type
+         */
+        [[nodiscard]] bool HasType(unsigned int type_) const;
+
+        /*
+         * Remove a row, destroying its elements.
+         * The last row is moved into its place.
+         */
+        void RemoveRow(unsigned int row_);
+    };
+
+    /*
+     * Archetype based storage for plain data components.
+     * Owned by a scene. Components of one type are stored contiguously, so systems that
+     * walk components do a linear sweep instead of chasing entity pointers.
+     */
+    class NEAPI ComponentStorage {
+        // Private Fields
+
+        /*
+         * Archetype lookup by signature
+         */
+        std::map<std::vector<unsigned int>, ComponentArchetype *> _ArchetypeLookup;
+
+        /*
+         * All archetypes
+         */
+        std::vector<std::unique_ptr<ComponentArchetype>> _Archetypes;
+
+        /*
+         * Whether or not structural changes are blocked
+         */
+        bool _Locked = false;
+
+        // Private Methods
+
+        /*
+         * Throw if structural changes are blocked
+         */
+        void CheckUnlocked() const;
+
+        /*
+         * Find the archetype gained by adding a component type to an archetype.
+         * The column for the new type is made with createColumn_ if the archetype does not exist.
+         */
+        ComponentArchetype *GetAddTarget(ComponentArchetype *archetype_, unsigned int type_,
+                                         ComponentColumn (*createColumn_)());
+
+        /*
+         * Get or create an archetype for a signature
+         */
+        ComponentArchetype *GetArchetype(const std::vector<unsigned int> &signature_,
+                                         std::vector<ComponentColumn> columns_);
+
+        /*
+         * Find the archetype gained by removing a component type from an archetype.
+         * Returns null if nothing would remain.
+         */
+        ComponentArchetype *GetRemoveTarget(ComponentArchetype *archetype_, unsigned int type_);
+
+        /*
+         * Move an entity's row into another archetype.
+         * Elements for types not in the source are left unconstructed.
+         */
+        unsigned int MoveEntity(BaseEntity *entity_, TComponentLocation &location_, ComponentArchetype *target_);
+    public:
+        // Public Constructor(s)
+
+        ComponentStorage() = default;
+
+        ComponentStorage(const ComponentStorage &storage_) = delete;
+
+        // Public Methods
+
+        /*
+         * Add a data component to an entity.
+         * If it already has one of this type, it is replaced.
+         * The returned pointer is only valid until the next structural change.
+         */
+        template <typename ComponentType>
+        ComponentType *Add(BaseEntity *entity_, TComponentLocation &location_, ComponentType component_) {
+            const unsigned int type = TypeID::Get<ComponentType>();
+
+            // Replace existing
+            if (location_.Archetype != nullptr) {
+                auto col = location_.Archetype->GetColumn(type);
+                if (col != nullptr) {
+                    auto existing = static_cast<ComponentType *>(col->At(location_.Row));
+                    *existing = std::move(component_);
+                    return existing;
+                }
+            }
+
+            // Move to the new archetype and construct the new element
+            CheckUnlocked();
+            auto target = GetAddTarget(location_.Archetype, type, &ComponentColumn::Create<ComponentType>);
+            auto row = MoveEntity(entity_, location_, target);
+            auto ptr = target->GetColumn(type)->At(row);
+            return new (ptr) ComponentType(std::move(component_));
+        }
+
+        /*
+         * Run a function over every entity that has all of the given data components.
+         * func_ is called as func_(BaseEntity *, ComponentTypes &...).
+         * Entities must not gain or lose data components during this call.
+         */
+        template <typename... ComponentTypes, typename Func>
+        void Each(Func func_) {
+            static_assert(sizeof...(ComponentTypes) > 0, "Each requires at least one component type.");
+
+            for (const auto &archetype : _Archetypes) {
+                auto count = archetype->GetCount();
+                if (count == 0) continue;
+
+                // Skip archetypes missing a type
+                if (!(archetype->HasType(TypeID::Get<ComponentTypes>()) && ...)) continue;
+
+                auto &entities = archetype->GetEntities();
+                EachIn<ComponentTypes...>(*archetype, entities.data(), count, func_);
+            }
+        }
+
+        /*
+         * Get a data component from an entity
+         */
+        template <typename ComponentType>
+        ComponentType *Get(const TComponentLocation &location_) const {
+            if (location_.Archetype == nullptr) return nullptr;
+
+            auto col = location_.Archetype->GetColumn(TypeID::Get<ComponentType>());
+            if (col == nullptr) return nullptr;
+
+            return static_cast<ComponentType *>(col->At(location_.Row));
+        }
+
+        /*
+         * Get all archetypes
+         */
+        [[nodiscard]] const std::vector<std::unique_ptr<ComponentArchetype>> &GetArchetypes() const;
+
+        /*
+         * Whether or not structural changes are blocked
+         */
+        [[nodiscard]] bool IsLocked() const;
+
+        /*
+         * Test whether an entity has a data component
+         */
+        template <typename ComponentType>
+        bool Has(const TComponentLocation &location_) const {
+            return location_.Archetype != nullptr && location_.Archetype->HasType(TypeID::Get<ComponentType>());
+        }
+
+        /*
+         * Remove a data component from an entity.
+         * Returns success or fail.
+         */
+        template <typename ComponentType>
+        bool Remove(BaseEntity *entity_, TComponentLocation &location_) {
+            return Remove(entity_, location_, TypeID::Get<ComponentType>());
+        }
+
+        /*
+         * Remove a data component from an entity by type ID.
+         * Returns success or fail.
+         */
+        bool Remove(BaseEntity *entity_, TComponentLocation &location_, unsigned int type_);
+
+        /*
+         * Remove all of an entity's data components
+         */
+        void RemoveAll(TComponentLocation &location_);
+
+        /*
+         * Block or allow structural changes.
+         * While locked, adding a new component type to an entity or removing one throws.
+         * Used while scene systems are running.
+         */
+        void SetLocked(bool locked_);
+
+    private:
+        // Private Methods
+
+        /*
+         * Run func_ over all rows of one archetype
+         */
+        template <typename... ComponentTypes, typename Func>
+        static void EachIn(ComponentArchetype &archetype_, BaseEntity *const *entities_, size_t count_, Func &func_) {
+            auto columns = std::make_tuple(
+                static_cast<ComponentTypes *>(archetype_.GetColumn(TypeID::Get<ComponentTypes>())->At(0))...);
+
+            for (size_t i = 0; i < count_; i++) {
+                func_(entities_[i], std::get<ComponentTypes *>(columns)[i]...);
+            }
+        }
+    };
+
+    /*
+     * Locks component storage for the scope it lives in.
+     * The storage is unlocked even if something throws.
+     */
+    class ComponentStorageLock {
+        // Private Fields
+
+        /*
+         * The locked storage
+         */
+        ComponentStorage &_Storage;
+
+    public:
+        // Public Constructor(s)
+
+        explicit ComponentStorageLock(ComponentStorage &storage_)
+            : _Storage(storage_) {
+            _Storage.SetLocked(true);
+        }
+
+        ComponentStorageLock(const ComponentStorageLock &) = delete;
+
+        // Destructor
+
+        ~ComponentStorageLock() {
+            _Storage.SetLocked(false);
+        }
+
+        // Operators
+
+        ComponentStorageLock &operator=(const ComponentStorageLock &) = delete;
+    };
+}
+
+#endif //COMPONENTSTORAGE_H
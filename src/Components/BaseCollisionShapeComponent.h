@@ -16,6 +16,8 @@
 
 #include "../ngine.h"
 
+#include "../Diagnostics/Profiler.h"
+#include "../Physics/BoundingBox.h"
 #include "BaseEntity.h"
 #include "Component.h"
 
@@ -27,9 +29,25 @@ namespace NerdThings::Ngine::Components {
         // Private Fields
 
         /*
-         * Collision group used
+         * Our proxy in the scene broadphase
          */
-        std::vector<std::string> _CollisionGroups = {"General"};
+        int _BroadphaseProxy = -1;
+
+        /*
+         * Bounds minimum when the proxy was last moved
+         */
+        TVector2 _BroadphasePosition;
+
+        /*
+         * The collision layers we are in, one bit per scene layer
+         */
+        unsigned int _CollisionCategory = 0;
+
+        /*
+         * The collision layers we check against.
+         * This follows our groups unless set directly.
+         */
+        unsigned int _CollisionMask = 0;
 
         /*
          * Whether or not to draw debug geometry
@@ -58,6 +76,11 @@ namespace NerdThings::Ngine::Components {
          */
         virtual void DrawDebug() = 0;
 
+        /*
+         * Get the axis aligned bounds of the current shape
+         */
+        virtual Physics::TBoundingBox GetShapeBounds() = 0;
+
         /*
          * Whether or not a shape is compatible.
          * This simple addition allows custom shapes to be added
@@ -69,6 +92,44 @@ namespace NerdThings::Ngine::Components {
          */
         virtual void Offset(TVector2 offset_) = 0;
 
+        /*
+         * Run narrowphase against every broadphase candidate in the layer mask.
+         * The shape should already be offset.
+         */
+        bool QueryCollisions(unsigned int mask_) {
+            NGINE_PROFILE_SCOPE("BaseCollisionShapeComponent::QueryCollisions");
+
+            auto collision = false;
+            auto parent = GetParent<BaseEntity>();
+            auto scene = parent->GetParentScene();
+
+            scene->GetCollisionBroadphase().Query(GetShapeBounds(), [&](void *data_) {
+                auto candidate = static_cast<BaseCollisionShapeComponent *>(data_);
+
+                if ((candidate->_CollisionCategory & mask_) == 0 || candidate->GetParent<BaseEntity>() == parent)
+                    return true;
+
+                if (IsCompatible(candidate)) {
+                    collision = CollisionCheck(candidate);
+                } else if (candidate->IsCompatible(this)) {
+                    collision = candidate->CollisionCheck(this);
+                }
+
+                // Stop once we find something
+                return !collision;
+            });
+
+            return collision;
+        }
+
+        /*
+         * Entity transform changed
+         */
+        void TransformChanged(EntityTransformChangedEventArgs &e) {
+            UpdateShape(e);
+            UpdateBroadphase();
+        }
+
         /*
          * Update shape information
          */
@@ -79,16 +140,11 @@ namespace NerdThings::Ngine::Components {
         virtual ~BaseCollisionShapeComponent() {
             _OnTransformChangeRef.UnBind();
 
-            // Remove from collision map
+            // Remove from the broadphase
             auto scene = GetParent<BaseEntity>()->GetParentScene();
 
-            for (auto cVec : scene->CollisionMap) {
-                for (auto ent : cVec.second) {
-                    if (ent == GetParent<BaseEntity>()) {
-                        scene->CollisionMap[cVec.first].erase(std::remove(scene->CollisionMap[cVec.first].begin(), scene->CollisionMap[cVec.first].end(), ent), scene->CollisionMap[cVec.first].end());
-                    }
-                }
-            }
+            if (_BroadphaseProxy >= 0)
+                scene->GetCollisionBroadphase().DestroyProxy(_BroadphaseProxy);
         }
 
         // Public Methods
@@ -96,15 +152,10 @@ namespace NerdThings::Ngine::Components {
         /*
          * Add a collision group
          */
-        void AddCollisionGroup(const std::string collisionGroup_) {
-            _CollisionGroups.push_back(collisionGroup_);
-
-            // Add to scene
-            auto scene = GetParent<BaseEntity>()->GetParentScene();
-            if (scene->CollisionMap.find(collisionGroup_) == scene->CollisionMap.end()) {
-                scene->CollisionMap[collisionGroup_] = std::vector<BaseEntity*>();
-            }
-            scene->CollisionMap[collisionGroup_].push_back(GetParent<BaseEntity>());
+        void AddCollisionGroup(const std::string &collisionGroup_) {
+            auto layer = GetParent<BaseEntity>()->GetParentScene()->GetCollisionLayerMask(collisionGroup_);
+            _CollisionCategory |= layer;
+            _CollisionMask |= layer;
         }
 
         /*
@@ -127,37 +178,7 @@ namespace NerdThings::Ngine::Components {
             Offset(diff);
 
             // Check for collision
-            auto collision = false;
-
-            auto scene = GetParent<BaseEntity>()->GetParentScene();
-
-            for (auto group : GetCollisionGroups()) {
-                auto candidates = scene->CollisionMap[group];
-
-                for (auto candidate : candidates) {
-                    if (candidate == GetParent<BaseEntity>())
-                        continue;
-
-                    auto components = candidate->GetComponents();
-
-                    for (auto component : components) {
-                        auto colShapeComp = dynamic_cast<BaseCollisionShapeComponent*>(component);
-                        if (colShapeComp != nullptr) {
-                            if (IsCompatible(colShapeComp)) {
-                                collision = CollisionCheck(colShapeComp);
-                            } else if (colShapeComp->IsCompatible(this)) {
-                                collision = colShapeComp->CollisionCheck(this);
-                            }
-
-                            if (collision) break;
-                        }
-                    }
-
-                    if (collision) break;
-                }
-
-                if (collision) break;
-            }
+            auto collision = QueryCollisions(_CollisionMask);
 
             // Un-offset shape
             Offset({-diff.X, -diff.Y});
@@ -209,12 +230,31 @@ namespace NerdThings::Ngine::Components {
             return CheckCollisionWithAt<EntityType>(collisionGroup_, GetParent<BaseEntity>()->GetPosition());
         }
 
+        /*
+         * Check for a collision with a set of collision layers.
+         * Get the mask from Scene::GetCollisionLayerMask.
+         */
+        template <typename EntityType>
+        bool CheckCollisionWith(unsigned int layerMask_) {
+            return CheckCollisionWithAt<EntityType>(layerMask_, GetParent<BaseEntity>()->GetPosition());
+        }
+
         /*
          * Check for a collision with a collision group at a position
          * Component must have the collision group to work
          */
         template <typename EntityType>
         bool CheckCollisionWithAt(const std::string &collisionGroup_, TVector2 position_) {
+            auto mask = GetParent<BaseEntity>()->GetParentScene()->FindCollisionLayerMask(collisionGroup_);
+            return CheckCollisionWithAt<EntityType>(mask, position_);
+        }
+
+        /*
+         * Check for a collision with a set of collision layers at a position.
+         * Get the mask from Scene::GetCollisionLayerMask.
+         */
+        template <typename EntityType>
+        bool CheckCollisionWithAt(unsigned int layerMask_, TVector2 position_) {
             auto curPos = GetParent<BaseEntity>()->GetPosition();
             auto diff = position_ - curPos;
 
@@ -222,35 +262,7 @@ namespace NerdThings::Ngine::Components {
             Offset(diff);
 
             // Check for collision
-            auto collision = false;
-
-            auto scene = GetParent<BaseEntity>()->GetParentScene();
-
-            if (scene->CollisionMap.find(collisionGroup_) != scene->CollisionMap.end()) {
-                auto candidates = scene->CollisionMap[collisionGroup_];
-
-                for (auto candidate : candidates) {
-                    if (candidate == GetParent<BaseEntity>() || candidate == nullptr)
-                        continue;
-
-                    auto components = candidate->GetComponents();
-
-                    for (auto component : components) {
-                        auto colShapeComp = dynamic_cast<BaseCollisionShapeComponent*>(component);
-                        if (colShapeComp != nullptr) {
-                            if (IsCompatible(colShapeComp)) {
-                                collision = CollisionCheck(colShapeComp);
-                            } else if (colShapeComp->IsCompatible(this)) {
-                                collision = colShapeComp->CollisionCheck(this);
-                            }
-
-                            if (collision) break;
-                        }
-                    }
-
-                    if (collision) break;
-                }
-            }
+            auto collision = QueryCollisions(layerMask_);
 
             // Un-offset shape
             Offset({-diff.X, -diff.Y});
@@ -286,30 +298,80 @@ namespace NerdThings::Ngine::Components {
             }
         }
 
+        /*
+         * Get the collision layers we are in
+         */
+        [[nodiscard]] unsigned int GetCollisionCategory() const {
+            return _CollisionCategory;
+        }
+
         /*
          * Get the set collision group
          */
         std::vector<std::string> GetCollisionGroups() {
-            return _CollisionGroups;
+            auto scene = GetParent<BaseEntity>()->GetParentScene();
+
+            std::vector<std::string> groups;
+            for (auto i = 0; i < MAX_COLLISION_LAYERS; i++) {
+                if (_CollisionCategory & (1u << i))
+                    groups.push_back(scene->GetCollisionLayerName(i));
+            }
+            return groups;
+        }
+
+        /*
+         * Get the collision layers we check against
+         */
+        [[nodiscard]] unsigned int GetCollisionMask() const {
+            return _CollisionMask;
+        }
+
+        /*
+         * Test whether we are in a collision group
+         */
+        bool HasCollisionGroup(const std::string &collisionGroup_) {
+            auto mask = GetParent<BaseEntity>()->GetParentScene()->FindCollisionLayerMask(collisionGroup_);
+            return (_CollisionCategory & mask) != 0;
         }
 
         /*
          * Remove a collision group
          */
-        void RemoveCollisionGroup(std::string collisionGroup_) {
-            _CollisionGroups.erase(std::remove(_CollisionGroups.begin(), _CollisionGroups.end(), collisionGroup_),
-                                   _CollisionGroups.end());
+        void RemoveCollisionGroup(const std::string &collisionGroup_) {
+            auto layer = GetParent<BaseEntity>()->GetParentScene()->FindCollisionLayerMask(collisionGroup_);
+            _CollisionCategory &= ~layer;
+            _CollisionMask &= ~layer;
+        }
 
-            // Remove from scene
-            auto scene = GetParent<BaseEntity>()->GetParentScene();
-            if (scene->CollisionMap.find(collisionGroup_) != scene->CollisionMap.end()) {
-                auto colVec = scene->CollisionMap[collisionGroup_];
-                colVec.erase(std::remove(colVec.begin(), colVec.end(), GetParent<BaseEntity>()), colVec.end());
-            }
+        /*
+         * Set the collision layers we check against.
+         * Adding or removing a group afterwards adds or removes its layer from this mask.
+         */
+        void SetCollisionMask(unsigned int mask_) {
+            _CollisionMask = mask_;
         }
 
     protected:
 
+        // Protected Methods
+
+        /*
+         * Move our broadphase proxy to the current shape bounds.
+         * Must be called whenever the shape changes.
+         */
+        void UpdateBroadphase() {
+            auto &broadphase = GetParent<BaseEntity>()->GetParentScene()->GetCollisionBroadphase();
+            auto bounds = GetShapeBounds();
+
+            if (_BroadphaseProxy < 0) {
+                _BroadphaseProxy = broadphase.CreateProxy(bounds, this);
+            } else {
+                broadphase.MoveProxy(_BroadphaseProxy, bounds, bounds.Min - _BroadphasePosition);
+            }
+
+            _BroadphasePosition = bounds.Min;
+        }
+
         // Protected Constructor(s)
 
         /*
@@ -318,9 +380,12 @@ namespace NerdThings::Ngine::Components {
         BaseCollisionShapeComponent(BaseEntity *parent_, std::string collisionGroup_ = "General")
             : Component(parent_) {
             _OnTransformChangeRef = GetParent<BaseEntity>()->OnTransformChanged.Bind(
-                this, &BaseCollisionShapeComponent::UpdateShape);
+                this, &BaseCollisionShapeComponent::TransformChanged);
+
+            AddCollisionGroup(collisionGroup_);
 
-            AddCollisionGroup(std::move(collisionGroup_));
+            // Everything checks against the general group, but is only in it if asked
+            _CollisionMask |= GetParent<BaseEntity>()->GetParentScene()->GetCollisionLayerMask("General");
         }
     };
 }
@@ -65,20 +65,30 @@ namespace NerdThings::Ngine::Components {
             if (CheckCollision<BaseEntity>())
                 col = Graphics::TColor::Green;
 
+            // Follow the interpolated position
+            auto drawPosition = par->GetDrawPosition();
+            auto offset = drawPosition - par->GetPosition();
+            auto min = _BoundingBox.Min + offset;
+            auto max = _BoundingBox.Max + offset;
+
             // Draw each vertex of the bounding box
-            Graphics::Drawing::DrawLine(_BoundingBox.Min, {_BoundingBox.Max.X, _BoundingBox.Min.Y}, col);
-            Graphics::Drawing::DrawLine({_BoundingBox.Max.X, _BoundingBox.Min.Y}, _BoundingBox.Max, col);
-            Graphics::Drawing::DrawLine(_BoundingBox.Max, {_BoundingBox.Min.X, _BoundingBox.Max.Y}, col);
-            Graphics::Drawing::DrawLine({_BoundingBox.Min.X, _BoundingBox.Max.Y}, _BoundingBox.Min, col);
+            Graphics::Drawing::DrawLine(min, {max.X, min.Y}, col);
+            Graphics::Drawing::DrawLine({max.X, min.Y}, max, col);
+            Graphics::Drawing::DrawLine(max, {min.X, max.Y}, col);
+            Graphics::Drawing::DrawLine({min.X, max.Y}, min, col);
 
             // Extra to understand how bounding boxes work
             if (DebugDrawInternalRectangle)
                 Graphics::Drawing::DrawRectangle(
-                    TRectangle(par->GetPosition() + TVector2(_Rectangle.X, _Rectangle.Y), _Rectangle.Width,
-                                     _Rectangle.Height), Graphics::TColor::Orange, par->GetRotation(),
+                    TRectangle(drawPosition + TVector2(_Rectangle.X, _Rectangle.Y), _Rectangle.Width,
+                                     _Rectangle.Height), Graphics::TColor::Orange, par->GetDrawRotation(),
                     par->GetOrigin());
         }
 
+        Physics::TBoundingBox GetShapeBounds() override {
+            return _BoundingBox;
+        }
+
         bool IsCompatible(BaseCollisionShapeComponent *b) override {
             // Due to how we laid out things, we can only check against other bounding boxes
             auto bbox = dynamic_cast<BoundingBoxCollisionShapeComponent*>(b);
@@ -143,6 +153,7 @@ namespace NerdThings::Ngine::Components {
                 par->GetPosition() - par->GetOrigin() + TVector2(_Rectangle.X, _Rectangle.Y),
                 _Rectangle.Width, _Rectangle.Height).ToBoundingBox(
                 par->GetRotation(), par->GetOrigin());
+            UpdateBroadphase();
         }
     };
 }
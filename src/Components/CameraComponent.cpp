@@ -19,6 +19,14 @@
 namespace NerdThings::Ngine::Components {
     // Private Methods
 
+    void CameraComponent::InterpolateCamera(EventArgs &e) {
+        _Camera.Target = GetParent<BaseEntity>()->GetDrawPosition();
+    }
+
+    void CameraComponent::RestoreCamera(EventArgs &e) {
+        _Camera.Target = GetParent<BaseEntity>()->GetPosition();
+    }
+
     void CameraComponent::UpdateCamera(EntityTransformChangedEventArgs &e) {
         // Update the target
         _Camera.Target = e.EntityPosition;
@@ -29,6 +37,8 @@ namespace NerdThings::Ngine::Components {
     // Destructor
 
     CameraComponent::~CameraComponent() {
+        _SceneDrawEvent.UnBind();
+        _SceneDrawFinishedEvent.UnBind();
         _TransformChangeEvent.UnBind();
     }
 
@@ -44,6 +54,10 @@ namespace NerdThings::Ngine::Components {
 
         // Attach to on position changed
         _TransformChangeEvent = par->OnTransformChanged.Bind(this, &CameraComponent::UpdateCamera);
+
+        // Follow the interpolated position while drawing
+        _SceneDrawEvent = par->GetParentScene()->OnDraw.Bind(this, &CameraComponent::InterpolateCamera);
+        _SceneDrawFinishedEvent = par->GetParentScene()->OnDrawFinished.Bind(this, &CameraComponent::RestoreCamera);
     }
 
     // Public Methods
@@ -33,6 +33,16 @@ namespace NerdThings::Ngine::Components {
          */
         Graphics::TCamera _Camera;
 
+        /*
+         * Reference to the scene draw event
+         */
+        EventHandleRef<EventArgs> _SceneDrawEvent;
+
+        /*
+         * Reference to the scene draw finished event
+         */
+        EventHandleRef<EventArgs> _SceneDrawFinishedEvent;
+
         /*
          * Reference to on position changed event
          */
@@ -40,6 +50,16 @@ namespace NerdThings::Ngine::Components {
 
         // Private Methods
 
+        /*
+         * Move the camera to the interpolated position before the scene draws
+         */
+        void InterpolateCamera(EventArgs &e);
+
+        /*
+         * Move the camera back to the entity once the scene has drawn, so updates see the real target
+         */
+        void RestoreCamera(EventArgs &e);
+
         /*
          * Update camera parameters
          */
@@ -72,8 +72,16 @@ namespace NerdThings::Ngine::Components {
             if (CheckCollision<BaseEntity>())
                 col = Graphics::TColor::Green;
 
-            // Draw the circle outline
-            Graphics::Drawing::DrawCircleLines(_Circle.Center, _Circle.Radius, col);
+            // Draw the circle outline, following the interpolated position
+            auto offset = par->GetDrawPosition() - par->GetPosition();
+            Graphics::Drawing::DrawCircleLines(_Circle.Center + offset, _Circle.Radius, col);
+        }
+
+        Physics::TBoundingBox GetShapeBounds() override {
+            Physics::TBoundingBox bounds;
+            bounds.Min = {_Circle.Center.X - _Circle.Radius, _Circle.Center.Y - _Circle.Radius};
+            bounds.Max = {_Circle.Center.X + _Circle.Radius, _Circle.Center.Y + _Circle.Radius};
+            return bounds;
         }
 
         bool IsCompatible(BaseCollisionShapeComponent *b) override {
@@ -121,6 +129,7 @@ namespace NerdThings::Ngine::Components {
             const auto par = GetParent<BaseEntity>();
             _Radius = radius_;
             _Circle = Physics::TCircle(par->GetPosition() - par->GetOrigin(), _Radius);
+            UpdateBroadphase();
         }
     };
 }
@@ -37,9 +37,24 @@ namespace NerdThings::Ngine::Components {
         Physics::TPolygon _Polygon;
 
         /*
-         * Polygon vertices
+         * The source polygon rotated around the entity origin, before translation
          */
-        std::vector<TVector2> _Vertices;
+        Physics::TPolygon _RotatedPolygon;
+
+        /*
+         * The origin _RotatedPolygon was built with
+         */
+        TVector2 _RotatedOrigin;
+
+        /*
+         * The rotation _RotatedPolygon was built with
+         */
+        float _RotatedRotation = 0;
+
+        /*
+         * The untransformed polygon
+         */
+        Physics::TPolygon _SourcePolygon;
 
         // Private Methods
 
@@ -72,17 +87,36 @@ namespace NerdThings::Ngine::Components {
         }
 
         void DrawDebug() override {
+            auto par = GetParent<BaseEntity>();
+
             // Determine color
             auto col = Graphics::TColor::Red;
             if (CheckCollision<BaseEntity>())
                 col = Graphics::TColor::Green;
 
+            // Follow the interpolated position
+            auto offset = par->GetDrawPosition() - par->GetPosition();
+
             // Draw every vertex of the polygon
-            Graphics::Drawing::DrawLine(_Polygon.Vertices[0], _Polygon.Vertices[1], col);
+            Graphics::Drawing::DrawLine(_Polygon.Vertices[0] + offset, _Polygon.Vertices[1] + offset, col);
             for (auto i = 1; i < _Polygon.VertexCount - 1; i++) {
-                Graphics::Drawing::DrawLine(_Polygon.Vertices[i], _Polygon.Vertices[i + 1], col);
+                Graphics::Drawing::DrawLine(_Polygon.Vertices[i] + offset, _Polygon.Vertices[i + 1] + offset, col);
             }
-            Graphics::Drawing::DrawLine(_Polygon.Vertices[_Polygon.VertexCount - 1], _Polygon.Vertices[0], col);
+            Graphics::Drawing::DrawLine(_Polygon.Vertices[_Polygon.VertexCount - 1] + offset, _Polygon.Vertices[0] + offset, col);
+        }
+
+        Physics::TBoundingBox GetShapeBounds() override {
+            Physics::TBoundingBox bounds;
+            if (_Polygon.VertexCount == 0)
+                return bounds;
+
+            bounds.Min = bounds.Max = _Polygon.Vertices[0];
+            for (auto i = 1; i < _Polygon.VertexCount; i++) {
+                const auto &v = _Polygon.Vertices[i];
+                bounds.Min = {std::min(bounds.Min.X, v.X), std::min(bounds.Min.Y, v.Y)};
+                bounds.Max = {std::max(bounds.Max.X, v.X), std::max(bounds.Max.Y, v.Y)};
+            }
+            return bounds;
         }
 
         bool IsCompatible(BaseCollisionShapeComponent *b) override {
@@ -103,24 +137,28 @@ namespace NerdThings::Ngine::Components {
         void Offset(TVector2 offset_) override {
             const auto par = GetParent<BaseEntity>();
 
-            // Offset vertices
-            std::vector<TVector2> vertices(_Vertices.size());
-            for (auto i = 0; i < _Vertices.size(); i++) {
-                vertices[i] = _Vertices[i];
-                vertices[i] = vertices[i].Rotate(par->GetOrigin(), par->GetRotation());
-                vertices[i] += par->GetPosition() - par->GetOrigin() + offset_;
+            // Rebuild with offset
+            TransformPolygon(par->GetPosition(), par->GetOrigin(), par->GetRotation(), offset_);
+        }
+
+        /*
+         * Transform the source polygon into _Polygon.
+         * The rotated polygon is reused if only the position changed.
+         */
+        void TransformPolygon(TVector2 position_, TVector2 origin_, float rotation_, TVector2 offset_) {
+            if (rotation_ != _RotatedRotation || origin_ != _RotatedOrigin) {
+                _RotatedPolygon = _SourcePolygon;
+                _RotatedPolygon.Rotate(origin_, rotation_);
+                _RotatedOrigin = origin_;
+                _RotatedRotation = rotation_;
             }
-            _Polygon = Physics::TPolygon(vertices);
+
+            _Polygon = _RotatedPolygon;
+            _Polygon.Translate(position_ - origin_ + offset_);
         }
 
         void UpdateShape(EntityTransformChangedEventArgs &e) override {
-            std::vector<TVector2> vertices(_Vertices.size());
-            for (auto i = 0; i < _Vertices.size(); i++) {
-                vertices[i] = _Vertices[i];
-                vertices[i] = vertices[i].Rotate(e.EntityOrigin, e.EntityRotation);
-                vertices[i] += e.EntityPosition - e.EntityOrigin;
-            }
-            _Polygon = Physics::TPolygon(vertices);
+            TransformPolygon(e.EntityPosition, e.EntityOrigin, e.EntityRotation, TVector2::Zero);
         }
 
     public:
@@ -129,11 +167,9 @@ namespace NerdThings::Ngine::Components {
 
         PolygonCollisionShapeComponent(BaseEntity *parent_, std::vector<TVector2> vertices_,
                                        std::string collisionGroup_ = "General")
-            : BaseCollisionShapeComponent(parent_, std::move(collisionGroup_)), _Vertices(std::move(vertices_)) {
-            const auto par = GetParent<BaseEntity>();
-
+            : BaseCollisionShapeComponent(parent_, std::move(collisionGroup_)) {
             // Create polygon
-            SetPolygon(Physics::TPolygon(_Vertices));
+            SetPolygon(Physics::TPolygon(vertices_));
         }
 
         PolygonCollisionShapeComponent(BaseEntity *parent_, Physics::TPolygon polygon_,
@@ -151,25 +187,23 @@ namespace NerdThings::Ngine::Components {
         }
 
         std::vector<TVector2> GetSourceVertices() {
-            return _Vertices;
+            return std::vector<TVector2>(_SourcePolygon.Vertices, _SourcePolygon.Vertices + _SourcePolygon.VertexCount);
         }
 
         void SetPolygon(const Physics::TPolygon &polygon_) {
             const auto par = GetParent<BaseEntity>();
 
-            // Grab vertices
-            _Vertices.resize(polygon_.VertexCount);
-            for (auto i = 0; i < polygon_.VertexCount; i++) {
-                _Vertices[i] = polygon_.Vertices[i];
-            }
+            // Grab vertices and make sure the hull is current
+            _SourcePolygon = polygon_;
+            _SourcePolygon.GenerateNormals();
 
-            std::vector<TVector2> vertices(_Vertices.size());
-            for (auto i = 0; i < _Vertices.size(); i++) {
-                vertices[i] = _Vertices[i];
-                vertices[i] = vertices[i].Rotate(par->GetOrigin(), par->GetRotation());
-                vertices[i] += par->GetPosition() - par->GetOrigin();
-            }
-            _Polygon = Physics::TPolygon(vertices);
+            // The source is its own unrotated polygon
+            _RotatedPolygon = _SourcePolygon;
+            _RotatedOrigin = TVector2::Zero;
+            _RotatedRotation = 0;
+
+            TransformPolygon(par->GetPosition(), par->GetOrigin(), par->GetRotation(), TVector2::Zero);
+            UpdateBroadphase();
         }
     };
 }
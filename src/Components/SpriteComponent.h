@@ -49,7 +49,7 @@ namespace NerdThings::Ngine::Components {
 
         void Draw(EventArgs &e) override {
             const auto par = GetParent<BaseEntity>();
-            _Sprite.Draw(par->GetPosition(), par->GetRotation(), par->GetOrigin());
+            _Sprite.Draw(par->GetDrawPosition(), par->GetDrawRotation(), par->GetOrigin());
         }
 
         Graphics::TSprite *GetSprite() {
@@ -0,0 +1,124 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef DELEGATE_H
+#define DELEGATE_H
+
+#include "ngine.h"
+
+#include <cstring>
+
+namespace NerdThings::Ngine {
+    /*
+     * A callable reference to a function or class method.
+     * The target is stored inline, so creating or copying a delegate never allocates.
+     */
+    template <typename ArgsType>
+    class Delegate {
+        /*
+         * An undefined class, so the compiler sizes its method pointers for the worst case
+         */
+        class TUnknownClass;
+
+        // Private Fields
+
+        /*
+         * The object to call the method on, null for free functions
+         */
+        void *_Object = nullptr;
+
+        /*
+         * The function or method pointer
+         */
+        alignas(void *) unsigned char _Target[sizeof(void (TUnknownClass::*)(ArgsType &))] = {};
+
+        /*
+         * Unpacks the target and calls it
+         */
+        void (*_Stub)(const Delegate &, ArgsType &) = nullptr;
+
+        // Private Methods
+
+        static void InvokeFunction(const Delegate &delegate_, ArgsType &e_) {
+            void (*func)(ArgsType &);
+            std::memcpy(&func, delegate_._Target, sizeof(func));
+            func(e_);
+        }
+
+        template <typename Class>
+        static void InvokeMethod(const Delegate &delegate_, ArgsType &e_) {
+            // Copy out before calling in case the delegate moves during the call
+            void (Class::*func)(ArgsType &);
+            std::memcpy(&func, delegate_._Target, sizeof(func));
+            auto obj = static_cast<Class *>(delegate_._Object);
+            (obj->*func)(e_);
+        }
+
+    public:
+        // Public Constructor(s)
+
+        /*
+         * Create a null delegate
+         */
+        Delegate() = default;
+
+        /*
+         * Create a delegate to a function
+         */
+        Delegate(void (*func_)(ArgsType &))
+            : _Stub(&InvokeFunction) {
+            static_assert(sizeof(func_) <= sizeof(_Target), "Function pointer does not fit in a delegate.");
+            std::memcpy(_Target, &func_, sizeof(func_));
+        }
+
+        /*
+         * Create a delegate to a class method
+         */
+        template <typename Class>
+        Delegate(Class *obj_, void (Class::*func_)(ArgsType &))
+            : _Object(obj_), _Stub(&InvokeMethod<Class>) {
+            static_assert(sizeof(func_) <= sizeof(_Target), "Method pointer does not fit in a delegate.");
+            std::memcpy(_Target, &func_, sizeof(func_));
+        }
+
+        // Public Methods
+
+        /*
+         * Call the delegate
+         */
+        void Invoke(ArgsType &e_) const {
+            _Stub(*this, e_);
+        }
+
+        /*
+         * Whether or not the delegate has no target
+         */
+        [[nodiscard]] bool IsNull() const {
+            return _Stub == nullptr;
+        }
+
+        /*
+         * Clear the delegate target
+         */
+        void Reset() {
+            _Object = nullptr;
+            _Stub = nullptr;
+        }
+
+        // Operators
+
+        void operator()(ArgsType &e_) const {
+            Invoke(e_);
+        }
+    };
+}
+
+#endif //DELEGATE_H
@@ -0,0 +1,168 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "CostTracker.h"
+
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "Profiler.h"
+
+namespace NerdThings::Ngine::Diagnostics {
+    /*
+     * Time spent in nested calls of the call running on this thread
+     */
+    static thread_local std::uint64_t ChildTime = 0;
+
+    /*
+     * Get a readable name for a type
+     */
+    static std::string GetTypeName(const std::type_info &type_) {
+#if defined(__GNUG__)
+        int status = 0;
+        auto demangled = abi::__cxa_demangle(type_.name(), nullptr, nullptr, &status);
+        if (status == 0 && demangled != nullptr) {
+            std::string name(demangled);
+            free(demangled);
+            return name;
+        }
+#endif
+        return type_.name();
+    }
+
+    /*
+     * Orders reports by last frame self time, most first
+     */
+    static bool CompareFrameCosts(const TTypeCostReport &a_, const TTypeCostReport &b_) {
+        return a_.GetFrameSelfTime() > b_.GetFrameSelfTime();
+    }
+
+    // Private Fields
+
+    std::atomic<bool> CostTracker::_Enabled{false};
+    std::mutex CostTracker::_Mutex;
+    std::unordered_map<std::type_index, std::unique_ptr<TTypeCost>> CostTracker::_Types;
+
+    // Public Methods
+
+    std::uint64_t CostTracker::BeginCall(std::uint64_t &outerChildTime_) {
+        outerChildTime_ = ChildTime;
+        ChildTime = 0;
+        return Profiler::Now();
+    }
+
+    void CostTracker::Dump(unsigned int count_) {
+        auto costs = GetFrameCosts();
+        if (count_ > 0 && costs.size() > count_)
+            costs.resize(count_);
+
+        ConsoleMessage("Last frame costs of " + std::to_string(costs.size()) + " types (self/inclusive us, calls):", "NOTICE", "COSTS");
+
+        for (const auto &cost : costs) {
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(1);
+            line << (cost.IsComponent ? "[Component] " : "[Entity] ") << cost.Name;
+            line << " | Update " << cost.Frame[COST_UPDATE].SelfTime / 1000.0 << "/"
+                 << cost.Frame[COST_UPDATE].InclusiveTime / 1000.0 << ", " << cost.Frame[COST_UPDATE].Calls;
+            line << " | Draw " << cost.Frame[COST_DRAW].SelfTime / 1000.0 << "/"
+                 << cost.Frame[COST_DRAW].InclusiveTime / 1000.0 << ", " << cost.Frame[COST_DRAW].Calls;
+            ConsoleMessage(line.str(), "NOTICE", "COSTS");
+        }
+    }
+
+    void CostTracker::EndCall(TTypeCost *cost_, ECostPhase phase_, std::uint64_t start_, std::uint64_t outerChildTime_) {
+        auto duration = Profiler::Now() - start_;
+        auto self = duration > ChildTime ? duration - ChildTime : 0;
+
+        // We are nested time of the enclosing call
+        ChildTime = outerChildTime_ + duration;
+
+        cost_->Calls[phase_].fetch_add(1, std::memory_order_relaxed);
+        cost_->InclusiveTime[phase_].fetch_add(duration, std::memory_order_relaxed);
+        cost_->SelfTime[phase_].fetch_add(self, std::memory_order_relaxed);
+    }
+
+    std::vector<TTypeCostReport> CostTracker::GetFrameCosts() {
+        std::vector<TTypeCostReport> costs;
+
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            for (const auto &type : _Types) {
+                const auto &report = type.second->Report;
+                if (report.Frame[COST_UPDATE].Calls > 0 || report.Frame[COST_DRAW].Calls > 0)
+                    costs.push_back(report);
+            }
+        }
+
+        std::sort(costs.begin(), costs.end(), CompareFrameCosts);
+        return costs;
+    }
+
+    bool CostTracker::GetTypeCosts(std::type_index type_, TTypeCostReport &report_) {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        auto it = _Types.find(type_);
+        if (it == _Types.end())
+            return false;
+        report_ = it->second->Report;
+        return true;
+    }
+
+    TTypeCost *CostTracker::GetTypeCost(const std::type_info &type_, bool component_) {
+        std::lock_guard<std::mutex> lock(_Mutex);
+
+        auto &cost = _Types[std::type_index(type_)];
+        if (cost == nullptr) {
+            cost = std::make_unique<TTypeCost>();
+            cost->Report.IsComponent = component_;
+            cost->Report.Name = GetTypeName(type_);
+            cost->Report.Type = type_;
+        }
+
+        return cost.get();
+    }
+
+    void CostTracker::NextFrame() {
+        std::lock_guard<std::mutex> lock(_Mutex);
+
+        for (auto &type : _Types) {
+            auto &cost = *type.second;
+            for (auto i = 0; i < COST_PHASE_COUNT; i++) {
+                auto &frame = cost.Report.Frame[i];
+                frame.Calls = cost.Calls[i].exchange(0, std::memory_order_relaxed);
+                frame.InclusiveTime = cost.InclusiveTime[i].exchange(0, std::memory_order_relaxed);
+                frame.SelfTime = cost.SelfTime[i].exchange(0, std::memory_order_relaxed);
+
+                auto &total = cost.Report.Total[i];
+                total.Calls += frame.Calls;
+                total.InclusiveTime += frame.InclusiveTime;
+                total.SelfTime += frame.SelfTime;
+            }
+        }
+    }
+
+    void CostTracker::Reset() {
+        std::lock_guard<std::mutex> lock(_Mutex);
+
+        for (auto &type : _Types) {
+            for (auto i = 0; i < COST_PHASE_COUNT; i++) {
+                type.second->Report.Total[i] = {};
+            }
+        }
+    }
+
+    void CostTracker::SetEnabled(bool enabled_) {
+        _Enabled.store(enabled_, std::memory_order_relaxed);
+    }
+}
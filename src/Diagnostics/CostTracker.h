@@ -0,0 +1,258 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef COSTTRACKER_H
+#define COSTTRACKER_H
+
+#include "../ngine.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace NerdThings::Ngine::Diagnostics {
+    /*
+     * The phase a call is attributed to
+     */
+    enum ECostPhase {
+        COST_UPDATE = 0,
+        COST_DRAW,
+        COST_PHASE_COUNT
+    };
+
+    /*
+     * Costs of one type, in one phase
+     */
+    struct TCostCounters {
+        // Public Fields
+
+        /*
+         * Number of calls
+         */
+        std::uint64_t Calls = 0;
+
+        /*
+         * Time in nanoseconds, including nested entities and components
+         */
+        std::uint64_t InclusiveTime = 0;
+
+        /*
+         * Time in nanoseconds, not including nested entities and components
+         */
+        std::uint64_t SelfTime = 0;
+    };
+
+    /*
+     * The costs of an entity or component type
+     */
+    struct TTypeCostReport {
+        // Public Fields
+
+        /*
+         * Costs during the last frame, indexed by phase
+         */
+        TCostCounters Frame[COST_PHASE_COUNT];
+
+        /*
+         * Whether or not this is a component type
+         */
+        bool IsComponent = false;
+
+        /*
+         * Readable type name
+         */
+        std::string Name;
+
+        /*
+         * Costs since tracking began or was reset, indexed by phase
+         */
+        TCostCounters Total[COST_PHASE_COUNT];
+
+        /*
+         * The type
+         */
+        std::type_index Type = typeid(void);
+
+        // Public Methods
+
+        /*
+         * Get the self time of the last frame across all phases
+         */
+        [[nodiscard]] std::uint64_t GetFrameSelfTime() const {
+            return Frame[COST_UPDATE].SelfTime + Frame[COST_DRAW].SelfTime;
+        }
+    };
+
+    /*
+     * Live cost counters of one type.
+     * Obtained with CostTracker::GetTypeCost and kept by entities and components.
+     */
+    struct TTypeCost {
+        // Public Fields
+
+        /*
+         * Calls this frame
+         */
+        std::atomic<std::uint64_t> Calls[COST_PHASE_COUNT] = {};
+
+        /*
+         * Inclusive time this frame
+         */
+        std::atomic<std::uint64_t> InclusiveTime[COST_PHASE_COUNT] = {};
+
+        /*
+         * The report, updated at the end of each frame
+         */
+        TTypeCostReport Report;
+
+        /*
+         * Self time this frame
+         */
+        std::atomic<std::uint64_t> SelfTime[COST_PHASE_COUNT] = {};
+    };
+
+    /*
+     * Attributes Update and Draw time to entity and component types.
+     * Entity time includes its event handlers, the components it runs are also reported on their own.
+     * Off by default, as every entity and component call reads the clock twice while on.
+     * Calls are only timed if NGINE_PROFILER is defined.
+     */
+    class NEAPI CostTracker {
+        // Private Fields
+
+        /*
+         * Whether or not calls are timed
+         */
+        static std::atomic<bool> _Enabled;
+
+        /*
+         * Lock for _Types and the reports
+         */
+        static std::mutex _Mutex;
+
+        /*
+         * Counters for every type seen
+         */
+        static std::unordered_map<std::type_index, std::unique_ptr<TTypeCost>> _Types;
+
+    public:
+        // Public Methods
+
+        /*
+         * Start timing a call on this thread.
+         * Use CostScope instead of calling this.
+         */
+        static std::uint64_t BeginCall(std::uint64_t &outerChildTime_);
+
+        /*
+         * Write the costs of the last frame, most expensive first
+         */
+        static void Dump(unsigned int count_ = 0);
+
+        /*
+         * Finish timing a call on this thread.
+         * Use CostScope instead of calling this.
+         */
+        static void EndCall(TTypeCost *cost_, ECostPhase phase_, std::uint64_t start_, std::uint64_t outerChildTime_);
+
+        /*
+         * Get the costs of the last frame, most expensive first.
+         * Types that did nothing last frame are left out.
+         */
+        static std::vector<TTypeCostReport> GetFrameCosts();
+
+        /*
+         * Get the costs of a single type.
+         * Returns false if the type has never been timed.
+         */
+        static bool GetTypeCosts(std::type_index type_, TTypeCostReport &report_);
+
+        /*
+         * Get the counters for a type, creating them if needed.
+         * The counters live as long as the program.
+         */
+        static TTypeCost *GetTypeCost(const std::type_info &type_, bool component_);
+
+        /*
+         * Whether or not calls are being timed
+         */
+        static bool IsEnabled() {
+            return _Enabled.load(std::memory_order_relaxed);
+        }
+
+        /*
+         * Close the current frame.
+         * Called by the game at the start of every update.
+         */
+        static void NextFrame();
+
+        /*
+         * Clear all totals
+         */
+        static void Reset();
+
+        /*
+         * Set whether or not calls are timed
+         */
+        static void SetEnabled(bool enabled_);
+    };
+
+    /*
+     * Times an entity or component call
+     */
+    class CostScope {
+        // Private Fields
+
+        /*
+         * The type counters
+         */
+        TTypeCost *_Cost;
+
+        /*
+         * Nested time of the enclosing call
+         */
+        std::uint64_t _OuterChildTime = 0;
+
+        /*
+         * The phase
+         */
+        ECostPhase _Phase;
+
+        /*
+         * The start time
+         */
+        std::uint64_t _Start;
+
+    public:
+        // Public Constructor(s)
+
+        CostScope(TTypeCost *cost_, ECostPhase phase_)
+            : _Cost(cost_), _Phase(phase_) {
+            _Start = CostTracker::BeginCall(_OuterChildTime);
+        }
+
+        CostScope(const CostScope &) = delete;
+
+        // Destructor
+
+        ~CostScope() {
+            CostTracker::EndCall(_Cost, _Phase, _Start, _OuterChildTime);
+        }
+
+        // Operators
+
+        CostScope &operator=(const CostScope &) = delete;
+    };
+}
+
+#endif //COSTTRACKER_H
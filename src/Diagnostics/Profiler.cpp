@@ -0,0 +1,308 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "Profiler.h"
+
+#include <fstream>
+#include <iomanip>
+
+namespace NerdThings::Ngine::Diagnostics {
+    /*
+     * Scopes recorded on one thread.
+     * Only the owning thread writes events and only NextFrame reads them, so no lock is needed.
+     */
+    struct TThreadBuffer {
+        /*
+         * Number of events held before scopes are dropped
+         */
+        static const std::uint64_t Capacity = 1 << 14;
+
+        /*
+         * Nesting depth of the owning thread
+         */
+        unsigned short Depth = 0;
+
+        /*
+         * Scopes dropped since the last frame
+         */
+        std::atomic<std::uint64_t> Dropped{0};
+
+        /*
+         * Event ring
+         */
+        std::unique_ptr<TProfileEvent[]> Events{new TProfileEvent[Capacity]};
+
+        /*
+         * Thread index
+         */
+        unsigned short Index = 0;
+
+        /*
+         * Whether or not a thread owns this buffer
+         */
+        std::atomic<bool> InUse{true};
+
+        /*
+         * Events read
+         */
+        std::atomic<std::uint64_t> Read{0};
+
+        /*
+         * Events written
+         */
+        std::atomic<std::uint64_t> Written{0};
+    };
+
+    /*
+     * Releases the thread buffer for reuse when the thread exits
+     */
+    struct TThreadBufferOwner {
+        TThreadBuffer *Buffer = nullptr;
+
+        ~TThreadBufferOwner() {
+            if (Buffer != nullptr)
+                Buffer->InUse.store(false, std::memory_order_release);
+        }
+    };
+
+    /*
+     * All thread buffers, never freed so NextFrame can always read them
+     */
+    static std::vector<std::unique_ptr<TThreadBuffer>> ThreadBuffers;
+
+    /*
+     * Lock for ThreadBuffers
+     */
+    static std::mutex ThreadBuffersMutex;
+
+    /*
+     * This thread's buffer.
+     * Kept apart from the owner, which has a destructor and so is slower to reach.
+     */
+    static thread_local TThreadBuffer *CurrentBuffer = nullptr;
+
+    /*
+     * Releases this thread's buffer on exit
+     */
+    static thread_local TThreadBufferOwner CurrentBufferOwner;
+
+    /*
+     * Claim a buffer for this thread
+     */
+    static TThreadBuffer &ClaimThreadBuffer() {
+        std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+
+        // Reuse a buffer left by a thread that has exited
+        for (auto &buffer : ThreadBuffers) {
+            if (!buffer->InUse.load(std::memory_order_acquire)) {
+                buffer->Depth = 0;
+                buffer->InUse.store(true, std::memory_order_relaxed);
+                CurrentBuffer = CurrentBufferOwner.Buffer = buffer.get();
+                return *buffer;
+            }
+        }
+
+        ThreadBuffers.push_back(std::make_unique<TThreadBuffer>());
+        ThreadBuffers.back()->Index = static_cast<unsigned short>(ThreadBuffers.size() - 1);
+        CurrentBuffer = CurrentBufferOwner.Buffer = ThreadBuffers.back().get();
+        return *CurrentBuffer;
+    }
+
+    /*
+     * Get this thread's buffer
+     */
+    static TThreadBuffer &GetThreadBuffer() {
+        if (CurrentBuffer != nullptr)
+            return *CurrentBuffer;
+        return ClaimThreadBuffer();
+    }
+
+    /*
+     * Write a string as a JSON string
+     */
+    static void WriteJSONString(std::ostream &stream_, const char *str_) {
+        stream_ << '"';
+        for (auto c = str_; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\')
+                stream_ << '\\';
+            stream_ << *c;
+        }
+        stream_ << '"';
+    }
+
+    // Private Fields
+
+    std::atomic<bool> Profiler::_Enabled{true};
+    unsigned int Profiler::_FrameCount = 0;
+    std::vector<TProfileFrame> Profiler::_Frames(120);
+    std::mutex Profiler::_FramesMutex;
+    std::uint64_t Profiler::_FrameNumber = 0;
+    std::uint64_t Profiler::_FrameStart = 0;
+
+    // Public Methods
+
+    std::uint64_t Profiler::BeginScope() {
+        GetThreadBuffer().Depth++;
+        return Now();
+    }
+
+    void Profiler::EndScope(const char *name_, std::uint64_t start_) {
+        auto end = Now();
+        auto &buffer = GetThreadBuffer();
+        buffer.Depth--;
+
+        // Drop the scope rather than overwrite ones not yet read
+        auto written = buffer.Written.load(std::memory_order_relaxed);
+        if (written - buffer.Read.load(std::memory_order_acquire) >= TThreadBuffer::Capacity) {
+            buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto &event = buffer.Events[written % TThreadBuffer::Capacity];
+        event.Name = name_;
+        event.Start = start_;
+        event.End = end;
+        event.Depth = buffer.Depth;
+        event.Thread = buffer.Index;
+
+        buffer.Written.store(written + 1, std::memory_order_release);
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string &path_) {
+        auto frames = GetFrames();
+
+        std::ofstream file(path_);
+        if (!file) {
+            ConsoleMessage("Failed to open \"" + path_ + "\" to write a trace.", "WARNING", "PROFILER");
+            return false;
+        }
+
+        // Timestamps are in microseconds from the oldest frame
+        auto base = frames.empty() ? 0 : frames.front().Start;
+        auto toMicroseconds = [base](std::uint64_t time_) {
+            return static_cast<double>(time_ - base) / 1000.0;
+        };
+
+        file << std::fixed << std::setprecision(3);
+        file << "{\"traceEvents\":[";
+        file << R"({"name":"thread_name","ph":"M","pid":0,"tid":0,"args":{"name":"Frames"}})";
+
+        unsigned int threadCount = 0;
+        for (const auto &frame : frames) {
+            file << ",{\"name\":\"Frame " << frame.Number << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+                 << ",\"ts\":" << toMicroseconds(frame.Start)
+                 << ",\"dur\":" << static_cast<double>(frame.GetDuration()) / 1000.0
+                 << ",\"args\":{\"dropped\":" << frame.Dropped << "}}";
+
+            for (const auto &event : frame.Events) {
+                // Scopes started before the oldest frame are clipped
+                auto start = std::max(event.Start, base);
+
+                file << ",{\"name\":";
+                WriteJSONString(file, event.Name);
+                file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.Thread + 1
+                     << ",\"ts\":" << toMicroseconds(start)
+                     << ",\"dur\":" << static_cast<double>(event.End - start) / 1000.0 << "}";
+
+                threadCount = std::max(threadCount, static_cast<unsigned int>(event.Thread) + 1);
+            }
+        }
+
+        for (unsigned int i = 0; i < threadCount; i++) {
+            file << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i + 1
+                 << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+        }
+
+        file << "]}";
+
+        if (!file) {
+            ConsoleMessage("Failed to write trace to \"" + path_ + "\".", "WARNING", "PROFILER");
+            return false;
+        }
+
+        ConsoleMessage("Wrote " + std::to_string(frames.size()) + " frames to \"" + path_ + "\".", "NOTICE", "PROFILER");
+        return true;
+    }
+
+    unsigned int Profiler::GetFrameHistory() {
+        std::lock_guard<std::mutex> lock(_FramesMutex);
+        return static_cast<unsigned int>(_Frames.size());
+    }
+
+    std::vector<TProfileFrame> Profiler::GetFrames() {
+        std::lock_guard<std::mutex> lock(_FramesMutex);
+
+        std::vector<TProfileFrame> frames;
+        frames.reserve(_FrameCount);
+        for (auto i = _FrameNumber - _FrameCount; i < _FrameNumber; i++) {
+            frames.push_back(_Frames[i % _Frames.size()]);
+        }
+        return frames;
+    }
+
+    void Profiler::NextFrame() {
+        auto now = Now();
+
+        std::lock_guard<std::mutex> lock(_FramesMutex);
+
+        // Nothing to close on the first call
+        if (_FrameStart == 0) {
+            _FrameStart = now;
+            return;
+        }
+
+        TProfileFrame *frame = nullptr;
+        if (!_Frames.empty()) {
+            frame = &_Frames[_FrameNumber % _Frames.size()];
+            frame->Number = _FrameNumber;
+            frame->Start = _FrameStart;
+            frame->End = now;
+            frame->Dropped = 0;
+            frame->Events.clear();
+        }
+
+        // Gather the scopes finished on every thread
+        {
+            std::lock_guard<std::mutex> buffersLock(ThreadBuffersMutex);
+            for (auto &buffer : ThreadBuffers) {
+                auto read = buffer->Read.load(std::memory_order_relaxed);
+                auto written = buffer->Written.load(std::memory_order_acquire);
+                auto dropped = buffer->Dropped.exchange(0, std::memory_order_relaxed);
+
+                if (frame != nullptr) {
+                    for (auto i = read; i < written; i++) {
+                        frame->Events.push_back(buffer->Events[i % TThreadBuffer::Capacity]);
+                    }
+                    frame->Dropped += dropped;
+                }
+
+                buffer->Read.store(written, std::memory_order_release);
+            }
+        }
+
+        if (frame != nullptr && _FrameCount < _Frames.size())
+            _FrameCount++;
+
+        _FrameNumber++;
+        _FrameStart = now;
+    }
+
+    void Profiler::SetEnabled(bool enabled_) {
+        _Enabled.store(enabled_, std::memory_order_relaxed);
+    }
+
+    void Profiler::SetFrameHistory(unsigned int frames_) {
+        std::lock_guard<std::mutex> lock(_FramesMutex);
+        _Frames.clear();
+        _Frames.resize(frames_);
+        _FrameCount = 0;
+    }
+}
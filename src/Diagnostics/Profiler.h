@@ -0,0 +1,256 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "../ngine.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace NerdThings::Ngine::Diagnostics {
+    /*
+     * A timed scope
+     */
+    struct TProfileEvent {
+        // Public Fields
+
+        /*
+         * Scope name. Must be a string literal, or otherwise outlive the profiler.
+         */
+        const char *Name = nullptr;
+
+        /*
+         * Start time in nanoseconds
+         */
+        std::uint64_t Start = 0;
+
+        /*
+         * End time in nanoseconds
+         */
+        std::uint64_t End = 0;
+
+        /*
+         * Nesting depth on its thread, 0 being outermost
+         */
+        unsigned short Depth = 0;
+
+        /*
+         * Index of the thread the scope ran on
+         */
+        unsigned short Thread = 0;
+
+        // Public Methods
+
+        /*
+         * Get the duration in nanoseconds
+         */
+        [[nodiscard]] std::uint64_t GetDuration() const {
+            return End - Start;
+        }
+    };
+
+    /*
+     * All scopes that finished during a frame
+     */
+    struct TProfileFrame {
+        // Public Fields
+
+        /*
+         * Scopes that were lost because a thread buffer was full
+         */
+        std::uint64_t Dropped = 0;
+
+        /*
+         * Frame end time in nanoseconds
+         */
+        std::uint64_t End = 0;
+
+        /*
+         * Scopes, in the order they finished on each thread
+         */
+        std::vector<TProfileEvent> Events;
+
+        /*
+         * Frame number
+         */
+        std::uint64_t Number = 0;
+
+        /*
+         * Frame start time in nanoseconds
+         */
+        std::uint64_t Start = 0;
+
+        // Public Methods
+
+        /*
+         * Get the duration in nanoseconds
+         */
+        [[nodiscard]] std::uint64_t GetDuration() const {
+            return End - Start;
+        }
+    };
+
+    /*
+     * Frame profiler.
+     * Scopes are recorded into per thread buffers without locking, then gathered into a ring of recent frames.
+     * Use NGINE_PROFILE_SCOPE to time a scope, this compiles away unless NGINE_PROFILER is defined.
+     */
+    class NEAPI Profiler {
+        // Private Fields
+
+        /*
+         * Whether or not scopes are recorded
+         */
+        static std::atomic<bool> _Enabled;
+
+        /*
+         * The number of valid frames in the ring
+         */
+        static unsigned int _FrameCount;
+
+        /*
+         * Recent frames, used as a ring
+         */
+        static std::vector<TProfileFrame> _Frames;
+
+        /*
+         * Lock for _Frames
+         */
+        static std::mutex _FramesMutex;
+
+        /*
+         * The number of frames completed
+         */
+        static std::uint64_t _FrameNumber;
+
+        /*
+         * The current frame start time
+         */
+        static std::uint64_t _FrameStart;
+
+    public:
+        // Public Methods
+
+        /*
+         * Begin a scope on this thread.
+         * Returns the start time. Use NGINE_PROFILE_SCOPE instead of calling this.
+         */
+        static std::uint64_t BeginScope();
+
+        /*
+         * End a scope on this thread.
+         * Use NGINE_PROFILE_SCOPE instead of calling this.
+         */
+        static void EndScope(const char *name_, std::uint64_t start_);
+
+        /*
+         * Write recent frames to a Chrome trace JSON file.
+         * Open it with chrome://tracing or Perfetto.
+         */
+        static bool ExportChromeTrace(const std::string &path_);
+
+        /*
+         * Get the number of frames kept
+         */
+        static unsigned int GetFrameHistory();
+
+        /*
+         * Get recent frames, oldest first
+         */
+        static std::vector<TProfileFrame> GetFrames();
+
+        /*
+         * Whether or not scopes are being recorded
+         */
+        static bool IsEnabled() {
+            return _Enabled.load(std::memory_order_relaxed);
+        }
+
+        /*
+         * Close the current frame and start the next.
+         * Called by the game at the start of every update.
+         */
+        static void NextFrame();
+
+        /*
+         * Get the profiler clock, in nanoseconds
+         */
+        static std::uint64_t Now() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /*
+         * Set whether or not scopes are recorded
+         */
+        static void SetEnabled(bool enabled_);
+
+        /*
+         * Set the number of frames kept.
+         * Clears the frames kept so far.
+         */
+        static void SetFrameHistory(unsigned int frames_);
+    };
+
+    /*
+     * Times the scope it lives in
+     */
+    class ProfileScope {
+        // Private Fields
+
+        /*
+         * The scope name
+         */
+        const char *_Name;
+
+        /*
+         * The start time, 0 if not recording
+         */
+        std::uint64_t _Start = 0;
+
+    public:
+        // Public Constructor(s)
+
+        explicit ProfileScope(const char *name_)
+            : _Name(name_) {
+            if (Profiler::IsEnabled())
+                _Start = Profiler::BeginScope();
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+
+        // Destructor
+
+        ~ProfileScope() {
+            if (_Start != 0)
+                Profiler::EndScope(_Name, _Start);
+        }
+
+        // Operators
+
+        ProfileScope &operator=(const ProfileScope &) = delete;
+    };
+}
+
+#define NGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define NGINE_PROFILE_CONCAT(a, b) NGINE_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(NGINE_PROFILER)
+#define NGINE_PROFILE_SCOPE(name) ::NerdThings::Ngine::Diagnostics::ProfileScope NGINE_PROFILE_CONCAT(__ngineProfileScope, __LINE__)(name)
+#else
+#define NGINE_PROFILE_SCOPE(name)
+#endif
+
+#endif //PROFILER_H
@@ -16,52 +16,79 @@
 #include "BaseEntity.h"
 
 namespace NerdThings::Ngine {
-    // Public Methods
+    // Private Methods
 
-    std::vector<BaseEntity *> EntityContainer::GetEntities() {
-        std::vector<BaseEntity*> vec;
+    void EntityContainer::InsertEntity(BaseEntity *entity_, const std::string &name_) {
+        entity_->InternalSetContainerIndex(static_cast<unsigned int>(_Entities.size()));
+        _Entities.push_back(entity_);
 
-        for (auto it = _Entities.begin(); it != _Entities.end(); ++it) {
-            vec.push_back(it->second);
+        if (!name_.empty()) {
+            entity_->InternalSetName(name_);
+            _EntityNames.insert({name_, entity_});
         }
 
-        return vec;
+        // Add to any type buckets
+        for (const auto &bucket : _TypeBuckets) {
+            if (bucket != nullptr) bucket->TryAdd(entity_);
+        }
     }
 
-    bool EntityContainer::HasEntity(const std::string &name_) {
-        return _Entities.find(name_) != _Entities.end();
+    EntityHandle EntityContainer::GetEntityHandle(BaseEntity *entity_) {
+        return entity_->GetHandle();
     }
 
-    bool EntityContainer::RemoveEntity(const std::string &name_) {
-        // Get the entity
-        const auto ent = GetEntity<BaseEntity>(name_);
+    // Public Methods
 
-        if (ent != nullptr) {
-            // Unsubscribe from updates
-            ent->UnsubscribeFromUpdate();
+    const std::vector<BaseEntity *> &EntityContainer::GetEntities() const {
+        return _Entities;
+    }
 
-            // Remove parent
-            RemoveEntityParent(ent);
+    bool EntityContainer::HasEntity(const std::string &name_) {
+        return _EntityNames.find(name_) != _EntityNames.end();
+    }
 
-            // Remove entity from map
-            _Entities.erase(name_);
+    bool EntityContainer::RemoveEntity(const std::string &name_) {
+        auto it = _EntityNames.find(name_);
 
-            return true;
-        }
+        if (it != _EntityNames.end())
+            return RemoveEntity(it->second);
 
         // We don't have this entity
         return false;
     }
 
     bool EntityContainer::RemoveEntity(BaseEntity *entity_) {
-        // Search for the entity
-        for (const auto& ent : _Entities) {
-            if (ent.second == entity_) {
-                return RemoveEntity(ent.first);;
-            }
+        if (entity_ == nullptr)
+            return false;
+
+        // Make sure this entity is ours
+        auto index = entity_->InternalGetContainerIndex();
+        if (index >= _Entities.size() || _Entities[index] != entity_)
+            return false;
+
+        // Unsubscribe from updates
+        entity_->UnsubscribeFromUpdate();
+
+        // Remove parent
+        RemoveEntityParent(entity_);
+
+        // Remove from the name index
+        if (!entity_->GetName().empty()) {
+            _EntityNames.erase(entity_->GetName());
+            entity_->InternalSetName("");
         }
 
-        // We don't have this entity
-        return false;
+        // Remove from type buckets
+        for (const auto &bucket : _TypeBuckets) {
+            if (bucket != nullptr) bucket->Remove(entity_);
+        }
+
+        // Swap the last entity into our place
+        auto last = _Entities.back();
+        _Entities[index] = last;
+        last->InternalSetContainerIndex(index);
+        _Entities.pop_back();
+
+        return true;
     }
 }
@@ -16,10 +16,82 @@
 
 #include "ngine.h"
 
+#include "EntityHandle.h"
+#include "TypeID.h"
+
 namespace NerdThings::Ngine {
     // We do this forward declaration instead of include because BaseEntity uses this.
     class NEAPI BaseEntity;
 
+    /*
+     * A list of the entities in a container that match a type.
+     * This is kept up to date as entities are added and removed.
+     */
+    class NEAPI IEntityTypeBucket {
+    public:
+        // Destructor
+
+        virtual ~IEntityTypeBucket() = default;
+
+        // Public Methods
+
+        /*
+         * Add an entity if it matches
+         */
+        virtual void TryAdd(BaseEntity *ent_) = 0;
+
+        /*
+         * Remove an entity if present
+         */
+        virtual void Remove(BaseEntity *ent_) = 0;
+    };
+
+    /*
+     * Entity type bucket for a single type.
+     * Matches the type and anything derived from it.
+     */
+    template <typename EntityType>
+    class EntityTypeBucket : public IEntityTypeBucket {
+        // Private Fields
+
+        /*
+         * Where each entity is in Entities
+         */
+        std::unordered_map<BaseEntity*, size_t> _Indices;
+
+    public:
+        // Public Fields
+
+        /*
+         * The matching entities
+         */
+        std::vector<EntityType*> Entities;
+
+        // Public Methods
+
+        void TryAdd(BaseEntity *ent_) override {
+            auto t = dynamic_cast<EntityType*>(ent_);
+            if (t == nullptr) return;
+
+            _Indices.insert({ent_, Entities.size()});
+            Entities.push_back(t);
+        }
+
+        void Remove(BaseEntity *ent_) override {
+            auto it = _Indices.find(ent_);
+            if (it == _Indices.end()) return;
+
+            // Swap the last entity into our place
+            auto index = it->second;
+            auto last = Entities.back();
+            Entities[index] = last;
+            _Indices[static_cast<BaseEntity*>(last)] = index;
+
+            Entities.pop_back();
+            _Indices.erase(ent_);
+        }
+    };
+
     /*
      * An Entity Container, this just provides functions for entity management.
      * This is not normally used by a game.
@@ -28,18 +100,54 @@ namespace NerdThings::Ngine {
         // Private Fields
 
         /*
-         * The counter for unnamed entities
+         * All of the entities in this container.
+         * Order is not preserved on removal.
          */
-        int _Counter = 0;
+        std::vector<BaseEntity*> _Entities;
 
         /*
-         * All of the entities in the scene.
-         * Every entity has a name.
+         * Optional name index.
+         * Only entities added with a name appear here.
          */
-        std::map<std::string, BaseEntity*> _Entities;
+        std::unordered_map<std::string, BaseEntity*> _EntityNames;
+
+        /*
+         * Type buckets, indexed by type ID.
+         * These are created the first time a type is queried.
+         */
+        std::vector<std::unique_ptr<IEntityTypeBucket>> _TypeBuckets;
 
         // Private Methods
 
+        /*
+         * Store an entity. name_ may be empty.
+         */
+        void InsertEntity(BaseEntity *entity_, const std::string &name_);
+
+        /*
+         * Get the type bucket for a type, creating it if needed
+         */
+        template <typename EntityType>
+        EntityTypeBucket<EntityType> *GetTypeBucket() {
+            auto id = TypeID::Get<EntityType>();
+
+            if (id >= _TypeBuckets.size())
+                _TypeBuckets.resize(id + 1);
+
+            auto &bucket = _TypeBuckets[id];
+
+            if (bucket == nullptr) {
+                // Fill from what we already have
+                auto newBucket = std::make_unique<EntityTypeBucket<EntityType>>();
+                for (auto e : _Entities) {
+                    newBucket->TryAdd(e);
+                }
+                bucket = std::move(newBucket);
+            }
+
+            return static_cast<EntityTypeBucket<EntityType>*>(bucket.get());
+        }
+
         /*
          * Remove an entity parent
          */
@@ -54,26 +162,23 @@ namespace NerdThings::Ngine {
 
         /*
          * Add an entity without a name.
-         * This will give the entity name a numerical value.
-         * Returns pair of name and entity if success, null for both if fail
+         * Returns the entity handle if success, a null handle if fail
          */
         template <typename EntityType>
-        std::pair<std::string, EntityType *> AddEntity(EntityType *entity_) {
+        EntityHandle AddEntity(EntityType *entity_) {
             // Cast to BaseEntity to ensure this is a valid type
             auto ent = dynamic_cast<BaseEntity*>(entity_);
 
             if (ent != nullptr) {
-                std::string name = "Unique" + std::to_string(_Counter);
-                _Entities.insert({name, ent});
-                _Counter++;
+                InsertEntity(ent, "");
 
                 // Set parent
                 SetEntityParent(ent);
 
-                return std::make_pair(name, entity_);
+                return GetEntityHandle(ent);
             }
 
-            return std::make_pair("", nullptr);
+            return {};
         }
 
         /*
@@ -81,7 +186,7 @@ namespace NerdThings::Ngine {
          * Returns entity if success, null if fail
          */
         template <typename EntityType>
-        EntityType *AddEntity(std::string name_, EntityType *entity_) {
+        EntityType *AddEntity(const std::string &name_, EntityType *entity_) {
             // Check the name is not taken
             if (HasEntity(name_))
                 return nullptr;
@@ -90,7 +195,7 @@ namespace NerdThings::Ngine {
             auto ent = dynamic_cast<BaseEntity*>(entity_);
 
             if (ent != nullptr) {
-                _Entities.insert({name_, ent});
+                InsertEntity(ent, name_);
 
                 // Set parent
                 SetEntityParent(ent);
@@ -106,29 +211,33 @@ namespace NerdThings::Ngine {
          */
         template <typename EntityType>
         int CountEntitiesOfType() {
-            int c = 0;
-            for (auto e : _Entities) {
-                if (dynamic_cast<EntityType*>(e.second) != nullptr) c++;
-            }
-            return c;
+            return static_cast<int>(GetTypeBucket<EntityType>()->Entities.size());
         }
 
         /*
          * Get all of the entities
          */
-        std::vector<BaseEntity*> GetEntities();
+        [[nodiscard]] const std::vector<BaseEntity*> &GetEntities() const;
 
         /*
-         * Get all of the entities of type
+         * Get all of the entities of type.
+         * The first query for a type scans the container, after that this is a copy of the type's list,
+         * so entities can be added or removed while going through it.
+         * Order is not preserved on removal.
          */
         template <typename EntityType>
         std::vector<EntityType*> GetEntitiesByType() {
-            std::vector<EntityType*> ents;
-            for (auto e : _Entities) {
-                auto t = dynamic_cast<EntityType*>(e.second);
-                if (t != nullptr) ents.push_back(t);
-            }
-            return ents;
+            return GetTypeBucket<EntityType>()->Entities;
+        }
+
+        /*
+         * Get all of the entities of type without copying.
+         * The list is only valid until an entity is next added or removed, so don't destroy entities while going through it.
+         * Order is not preserved on removal.
+         */
+        template <typename EntityType>
+        const std::vector<EntityType*> &GetEntitiesByTypeView() {
+            return GetTypeBucket<EntityType>()->Entities;
         }
 
         /*
@@ -137,8 +246,9 @@ namespace NerdThings::Ngine {
         template <typename EntityType>
         EntityType *GetEntity(const std::string &name_) {
             // Try to find the entity
-            if (HasEntity(name_)) {
-                return dynamic_cast<EntityType*>(_Entities.at(name_)); // Will return null if its the wrong type
+            auto it = _EntityNames.find(name_);
+            if (it != _EntityNames.end()) {
+                return dynamic_cast<EntityType*>(it->second); // Will return null if its the wrong type
             }
 
             return nullptr;
@@ -159,6 +269,15 @@ namespace NerdThings::Ngine {
          * Remove entity by pointer.
          */
         bool RemoveEntity(BaseEntity *entity_);
+
+    private:
+        // Private Methods
+
+        /*
+         * Get the handle of an entity.
+         * This lives here so the templates above do not need BaseEntity.
+         */
+        static EntityHandle GetEntityHandle(BaseEntity *entity_);
     };
 }
 
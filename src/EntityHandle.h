@@ -0,0 +1,65 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef ENTITYHANDLE_H
+#define ENTITYHANDLE_H
+
+#include "ngine.h"
+
+namespace NerdThings::Ngine {
+    /*
+     * A weak reference to an entity.
+     * Handles are resolved through the scene and stop resolving once the entity is destroyed,
+     * even if its slot is reused by a new entity.
+     */
+    struct NEAPI EntityHandle {
+        // Public Fields
+
+        /*
+         * The slot index in the scene
+         */
+        unsigned int Index = 0;
+
+        /*
+         * The slot generation.
+         * Generation 0 is never issued, so a default handle is always null.
+         */
+        unsigned int Generation = 0;
+
+        // Public Constructor(s)
+
+        EntityHandle() = default;
+
+        EntityHandle(unsigned int index_, unsigned int generation_)
+            : Index(index_), Generation(generation_) {}
+
+        // Public Methods
+
+        /*
+         * Whether or not this handle was never set
+         */
+        [[nodiscard]] bool IsNull() const {
+            return Generation == 0;
+        }
+
+        // Operators
+
+        bool operator==(const EntityHandle &b_) const {
+            return Index == b_.Index && Generation == b_.Generation;
+        }
+
+        bool operator!=(const EntityHandle &b_) const {
+            return !(*this == b_);
+        }
+    };
+}
+
+#endif //ENTITYHANDLE_H
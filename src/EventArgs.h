@@ -130,6 +130,25 @@ namespace NerdThings::Ngine {
                 : ParentGame(game_) {}
     };
 
+    struct SimulationTimeDroppedEventArgs : EventArgs {
+        // Public Fields
+
+        /*
+         * Simulation time that will never be updated
+         */
+        std::chrono::nanoseconds Dropped;
+
+        /*
+         * Updates run this frame before giving up
+         */
+        unsigned int UpdatesRun;
+
+        // Public Constructor(s)
+
+        SimulationTimeDroppedEventArgs(std::chrono::nanoseconds dropped_, unsigned int updatesRun_)
+                : Dropped(dropped_), UpdatesRun(updatesRun_) {}
+    };
+
     struct UIControlEventArgs : EventArgs {
         // Public Fields
 
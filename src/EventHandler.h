@@ -14,7 +14,8 @@
 
 #include "ngine.h"
 
-#include <functional>
+#include "Delegate.h"
+#include "Diagnostics/Profiler.h"
 
 namespace NerdThings::Ngine {
     /*
@@ -67,113 +68,173 @@ namespace NerdThings::Ngine {
      */
     template <typename ArgsType>
     class EventHandler {
+        /*
+         * A bound handle
+         */
+        struct TEventHandle {
+            /*
+             * The handle delegate, null if unbound and awaiting compaction
+             */
+            Delegate<ArgsType> Function;
+
+            /*
+             * The handle ID given out in references
+             */
+            int ID;
+        };
+
         // Private Fields
 
         /*
-         * All of the handles for the event handler
+         * Free handle IDs
          */
-        std::vector<std::function<void(ArgsType &)>> _Handles;
+        std::vector<int> _FreeIDs;
 
         /*
-         * Unused indices in the Handles vector
+         * Handle indices by ID, -1 if free
          */
-        std::vector<int> _UnusedIndices;
-
-    public:
-        // Public Constructor(s)
-
-        EventHandler<ArgsType>() = default;
-
-        // Public Methods
+        std::vector<int> _HandleIndices;
 
         /*
-         * Bind a function
+         * All of the handles for the event handler, in bind order
          */
-        EventHandleRef<ArgsType> Bind(void (*func_)(ArgsType &e)) {
-            auto f = std::bind(func_, std::placeholders::_1);
-            if (_UnusedIndices.size() > 0) {
-                auto id = _UnusedIndices.back();
+        std::vector<TEventHandle> _Handles;
 
-                _Handles[id] = f;
+        /*
+         * How many invokes are running.
+         * The handle list is not compacted while this is above 0.
+         */
+        int _Invoking = 0;
 
-                _UnusedIndices.erase(_UnusedIndices.end() - 1, _UnusedIndices.end());
+        /*
+         * Number of unbound handles still in the list
+         */
+        unsigned int _Removed = 0;
 
-                EventHandleRef<ArgsType> ref;
-                ref.AttachedHandler = this;
-                ref.ID = id;
+        // Private Methods
 
-                return ref;
+        /*
+         * Add a handle and give out a reference
+         */
+        EventHandleRef<ArgsType> AddHandle(const Delegate<ArgsType> &function_) {
+            int id;
+            if (!_FreeIDs.empty()) {
+                id = _FreeIDs.back();
+                _FreeIDs.pop_back();
+            } else {
+                id = static_cast<int>(_HandleIndices.size());
+                _HandleIndices.push_back(-1);
             }
 
-            _Handles.push_back(f);
+            _HandleIndices[id] = static_cast<int>(_Handles.size());
+            _Handles.push_back({function_, id});
 
             EventHandleRef<ArgsType> ref;
             ref.AttachedHandler = this;
-            ref.ID = _Handles.size() - 1;
+            ref.ID = id;
 
             return ref;
         }
 
         /*
-         * Bind a class method
+         * Drop unbound handles, keeping bind order
          */
-        template <typename Class>
-        EventHandleRef<ArgsType> Bind(Class *obj_, void (Class::*func_)(ArgsType &e)) {
-            auto f = std::bind(func_, obj_, std::placeholders::_1);
-            if (!_UnusedIndices.empty()) {
-                auto id = _UnusedIndices.back();
-
-                _Handles[id] = f;
+        void Compact() {
+            size_t count = 0;
+            for (size_t i = 0; i < _Handles.size(); i++) {
+                if (_Handles[i].Function.IsNull())
+                    continue;
+
+                if (count != i)
+                    _Handles[count] = _Handles[i];
+                _HandleIndices[_Handles[count].ID] = static_cast<int>(count);
+                count++;
+            }
 
-                _UnusedIndices.erase(_UnusedIndices.end() - 1, _UnusedIndices.end());
+            _Handles.resize(count);
+            _Removed = 0;
+        }
 
-                EventHandleRef<ArgsType> ref;
-                ref.AttachedHandler = this;
-                ref.ID = id;
+    public:
+        // Public Constructor(s)
 
-                return ref;
-            }
+        EventHandler<ArgsType>() = default;
 
-            _Handles.push_back(f);
+        // Public Methods
 
-            EventHandleRef<ArgsType> ref;
-            ref.AttachedHandler = this;
-            ref.ID = _Handles.size() - 1;
+        /*
+         * Bind a function
+         */
+        EventHandleRef<ArgsType> Bind(void (*func_)(ArgsType &e)) {
+            return AddHandle(Delegate<ArgsType>(func_));
+        }
 
-            return ref;
+        /*
+         * Bind a class method
+         */
+        template <typename Class>
+        EventHandleRef<ArgsType> Bind(Class *obj_, void (Class::*func_)(ArgsType &e)) {
+            return AddHandle(Delegate<ArgsType>(obj_, func_));
         }
 
         /*
          * Clear all event handles
          */
         [[deprecated("Clearing is unsafe and will be removed on the next release.")]] void Clear() {
-            _Handles.clear();
+            for (auto &handle : _Handles) {
+                if (!handle.Function.IsNull())
+                    UnBind(handle.ID);
+            }
         }
 
         /*
-         * Invoke the handles attached to the event
+         * Invoke the handles attached to the event.
+         * Every handle is given the same arguments, UnBind is reset between them.
          */
         void Invoke(ArgsType e) {
-            for (auto i = 0; i < _Handles.size(); i++) {
-                auto handle = _Handles[i];
-                if (handle != nullptr) {
-                    ArgsType sendE = e;
-                    handle(sendE);
-
-                    if (sendE.UnBind)
-                        UnBind(i);
-                }
+            if (_Handles.empty())
+                return;
+
+            NGINE_PROFILE_SCOPE("EventHandler::Invoke");
+
+            _Invoking++;
+
+            // Handles bound during the invoke are run too
+            for (size_t i = 0; i < _Handles.size(); i++) {
+                const auto &handle = _Handles[i];
+                if (handle.Function.IsNull())
+                    continue;
+
+                auto id = handle.ID;
+                e.UnBind = false;
+                handle.Function.Invoke(e);
+
+                if (e.UnBind)
+                    UnBind(id);
             }
+
+            _Invoking--;
+
+            // Compact once too much of the list is dead
+            if (_Invoking == 0 && _Removed * 2 > _Handles.size())
+                Compact();
         }
 
         /*
-         * Unbind an event handle by index
+         * Unbind an event handle by ID
          */
-        void UnBind(int index) {
-            if (index < 0)
+        void UnBind(int id_) {
+            if (id_ < 0 || static_cast<size_t>(id_) >= _HandleIndices.size() || _HandleIndices[id_] < 0)
                 return;
-            _Handles[index] = nullptr;
-            _UnusedIndices.push_back(index);
+
+            // Leave a gap, the list may be being invoked
+            _Handles[_HandleIndices[id_]].Function.Reset();
+            _HandleIndices[id_] = -1;
+            _FreeIDs.push_back(id_);
+            _Removed++;
+
+            if (_Invoking == 0 && _Removed * 2 > _Handles.size())
+                Compact();
         }
 
         // Operators
@@ -0,0 +1,173 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include "ngine.h"
+
+#include <mutex>
+
+#include "EventHandler.h"
+
+namespace NerdThings::Ngine {
+    /*
+     * A batch of queued events.
+     * The events are only valid for the duration of the handler.
+     */
+    template <typename EventType>
+    struct EventBatchArgs : EventArgs {
+        // Public Fields
+
+        /*
+         * The number of events
+         */
+        size_t Count = 0;
+
+        /*
+         * The first event
+         */
+        const EventType *Events = nullptr;
+
+        // Public Constructor(s)
+
+        EventBatchArgs(const EventType *events_, size_t count_)
+            : Count(count_), Events(events_) {}
+
+        // Public Methods
+
+        const EventType *begin() const {
+            return Events;
+        }
+
+        const EventType *end() const {
+            return Events + Count;
+        }
+
+        // Operators
+
+        const EventType &operator[](size_t index_) const {
+            return Events[index_];
+        }
+    };
+
+    /*
+     * An event queue, type erased for dispatching
+     */
+    class NEAPI IEventQueue {
+    public:
+        // Destructor
+
+        virtual ~IEventQueue() = default;
+
+        // Public Methods
+
+        /*
+         * Deliver everything posted so far as one batch
+         */
+        virtual void Dispatch() = 0;
+    };
+
+    /*
+     * A queue of events of one type.
+     * Events can be posted from any thread and are delivered in bulk when the queue is dispatched.
+     */
+    template <typename EventType>
+    class EventQueue : public IEventQueue {
+        // Private Fields
+
+        /*
+         * Events being dispatched.
+         * Swapped with _Posted so dispatching does not hold the lock.
+         */
+        std::vector<EventType> _Dispatching;
+
+        /*
+         * Whether or not we are dispatching
+         */
+        bool _IsDispatching = false;
+
+        /*
+         * Lock for _Posted
+         */
+        std::mutex _Mutex;
+
+        /*
+         * Events waiting for dispatch
+         */
+        std::vector<EventType> _Posted;
+
+    public:
+        // Public Fields
+
+        /*
+         * On batch of events.
+         * Fired once per dispatch if anything was posted.
+         */
+        EventHandler<EventBatchArgs<EventType>> OnBatch;
+
+        // Public Methods
+
+        void Dispatch() override {
+            // Handlers posting to this queue will have their events delivered next dispatch
+            if (_IsDispatching)
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(_Mutex);
+                if (_Posted.empty())
+                    return;
+                std::swap(_Posted, _Dispatching);
+            }
+
+            // Finish the dispatch even if a handler throws, so the queue isn't stuck or sent the batch again
+            struct DispatchGuard {
+                EventQueue *Queue;
+
+                ~DispatchGuard() {
+                    Queue->_IsDispatching = false;
+
+                    // Keep the capacity for reuse
+                    Queue->_Dispatching.clear();
+                }
+            } guard{this};
+
+            _IsDispatching = true;
+            OnBatch({_Dispatching.data(), _Dispatching.size()});
+        }
+
+        /*
+         * Get the number of events waiting
+         */
+        size_t GetPendingCount() {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            return _Posted.size();
+        }
+
+        /*
+         * Post an event. Thread safe.
+         */
+        void Post(const EventType &event_) {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Posted.push_back(event_);
+        }
+
+        /*
+         * Post an event. Thread safe.
+         */
+        void Post(EventType &&event_) {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Posted.push_back(std::move(event_));
+        }
+    };
+}
+
+#endif //EVENTQUEUE_H
@@ -0,0 +1,154 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "FramePacer.h"
+
+#include <cmath>
+
+namespace NerdThings::Ngine {
+    /*
+     * The most sleep may be out by for us to use it, beyond this we spin the whole wait
+     */
+    static const std::chrono::nanoseconds MaxSleepGranularity = std::chrono::milliseconds(4);
+
+    // Private Methods
+
+    void FramePacer::RecordFrame(std::chrono::steady_clock::time_point now_) {
+        auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(now_ - _LastFrame).count();
+        _LastFrame = now_;
+
+        _FrameTimes[_FrameCount % _FrameTimes.size()] = static_cast<std::uint64_t>(time);
+        _FrameCount++;
+    }
+
+    void FramePacer::Sleep(std::chrono::nanoseconds duration_) {
+        auto before = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(duration_);
+        auto overshoot = std::chrono::steady_clock::now() - before - duration_;
+
+        // Grow straight away so the next wait isn't late, shrink slowly so one good sleep isn't trusted
+        if (overshoot > _SleepGranularity)
+            _SleepGranularity = std::chrono::duration_cast<std::chrono::nanoseconds>(overshoot);
+        else
+            _SleepGranularity -= (_SleepGranularity - overshoot) / 64;
+    }
+
+    // Public Constructor(s)
+
+    FramePacer::FramePacer(int FPS_, unsigned int history_)
+        : _FrameTimes(history_ > 0 ? history_ : 1) {
+        SetTargetFPS(FPS_);
+        Calibrate();
+    }
+
+    // Public Methods
+
+    void FramePacer::Calibrate() {
+        std::chrono::nanoseconds worst(0);
+        const auto request = std::chrono::milliseconds(1);
+
+        for (auto i = 0; i < 8; i++) {
+            auto before = std::chrono::steady_clock::now();
+            std::this_thread::sleep_for(request);
+            auto overshoot = std::chrono::steady_clock::now() - before - request;
+            worst = std::max(worst, std::chrono::duration_cast<std::chrono::nanoseconds>(overshoot));
+        }
+
+        _SleepGranularity = worst;
+    }
+
+    std::chrono::nanoseconds FramePacer::GetInterval() const {
+        return _Interval;
+    }
+
+    std::chrono::nanoseconds FramePacer::GetSleepGranularity() const {
+        return _SleepGranularity;
+    }
+
+    TFrameTimeStats FramePacer::GetStats() const {
+        TFrameTimeStats stats;
+        stats.Frames = static_cast<unsigned int>(std::min<std::uint64_t>(_FrameCount, _FrameTimes.size()));
+        if (stats.Frames == 0)
+            return stats;
+
+        stats.Min = _FrameTimes[0];
+        auto sum = 0.0;
+        for (unsigned int i = 0; i < stats.Frames; i++) {
+            auto time = _FrameTimes[i];
+            stats.Min = std::min(stats.Min, time);
+            stats.Max = std::max(stats.Max, time);
+            sum += static_cast<double>(time);
+
+            if (_Interval.count() > 0 && time * 2 > static_cast<std::uint64_t>(_Interval.count()) * 3)
+                stats.Late++;
+        }
+        stats.Mean = sum / stats.Frames;
+
+        auto variance = 0.0;
+        for (unsigned int i = 0; i < stats.Frames; i++) {
+            auto difference = static_cast<double>(_FrameTimes[i]) - stats.Mean;
+            variance += difference * difference;
+        }
+        stats.Jitter = std::sqrt(variance / stats.Frames);
+
+        return stats;
+    }
+
+    void FramePacer::Reset() {
+        _FrameCount = 0;
+        _Started = false;
+    }
+
+    void FramePacer::SetTargetFPS(int FPS_) {
+        auto interval = FPS_ > 0 ? std::chrono::nanoseconds(1000000000LL / FPS_) : std::chrono::nanoseconds(0);
+        if (interval == _Interval)
+            return;
+
+        _Interval = interval;
+        Reset();
+    }
+
+    void FramePacer::WaitForNextFrame() {
+        auto now = std::chrono::steady_clock::now();
+
+        // The first frame sets up the grid
+        if (!_Started) {
+            _Started = true;
+            _LastFrame = now;
+            _NextFrame = now + _Interval;
+            return;
+        }
+
+        if (_Interval.count() > 0) {
+            // Sleep for as much of the wait as we can trust the OS with, if we can trust it at all
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(_NextFrame - now);
+            if (_SleepGranularity > MaxSleepGranularity) {
+                // Spin the whole wait, but let one bad sleep wear off so we try sleeping again later
+                auto excess = _SleepGranularity - MaxSleepGranularity;
+                _SleepGranularity -= std::max(excess / 64, std::chrono::nanoseconds(1));
+            } else if (remaining > _SleepGranularity) {
+                Sleep(remaining - _SleepGranularity);
+            }
+
+            // Spin the rest
+            while ((now = std::chrono::steady_clock::now()) < _NextFrame)
+                std::this_thread::yield();
+
+            _NextFrame += _Interval;
+
+            // More than a frame behind, start over from now instead of rushing to catch up
+            if (now >= _NextFrame)
+                _NextFrame = now + _Interval;
+        }
+
+        RecordFrame(now);
+    }
+}
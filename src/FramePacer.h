@@ -0,0 +1,166 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "ngine.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace NerdThings::Ngine {
+    /*
+     * Frame time statistics over recent frames
+     */
+    struct TFrameTimeStats {
+        // Public Fields
+
+        /*
+         * Number of frames measured
+         */
+        unsigned int Frames = 0;
+
+        /*
+         * Shortest frame in nanoseconds
+         */
+        std::uint64_t Min = 0;
+
+        /*
+         * Longest frame in nanoseconds
+         */
+        std::uint64_t Max = 0;
+
+        /*
+         * Mean frame time in nanoseconds
+         */
+        double Mean = 0;
+
+        /*
+         * Standard deviation of the frame time in nanoseconds
+         */
+        double Jitter = 0;
+
+        /*
+         * Frames that took more than one and a half intervals
+         */
+        unsigned int Late = 0;
+    };
+
+    /*
+     * Paces frames to a target rate.
+     * Waits by sleeping until the OS sleep granularity away from the deadline, then spinning.
+     * Deadlines are kept on a fixed nanosecond grid so the rate does not drift.
+     */
+    class NEAPI FramePacer {
+        // Private Fields
+
+        /*
+         * Recent frame times in nanoseconds, used as a ring
+         */
+        std::vector<std::uint64_t> _FrameTimes;
+
+        /*
+         * Total frames recorded
+         */
+        std::uint64_t _FrameCount = 0;
+
+        /*
+         * Time between frames, zero for no limit
+         */
+        std::chrono::nanoseconds _Interval{0};
+
+        /*
+         * When the last frame ended
+         */
+        std::chrono::steady_clock::time_point _LastFrame;
+
+        /*
+         * The deadline of the next frame
+         */
+        std::chrono::steady_clock::time_point _NextFrame;
+
+        /*
+         * Whether or not a frame has ended yet
+         */
+        bool _Started = false;
+
+        /*
+         * The longest we expect a sleep to overshoot by
+         */
+        std::chrono::nanoseconds _SleepGranularity{0};
+
+        // Private Methods
+
+        /*
+         * Record a frame time
+         */
+        void RecordFrame(std::chrono::steady_clock::time_point now_);
+
+        /*
+         * Sleep, learning from any overshoot
+         */
+        void Sleep(std::chrono::nanoseconds duration_);
+
+    public:
+        // Public Constructor(s)
+
+        /*
+         * Create a frame pacer.
+         * An FPS of 0 or less does not limit the rate, frame times are still recorded.
+         */
+        explicit FramePacer(int FPS_ = 0, unsigned int history_ = 120);
+
+        // Public Methods
+
+        /*
+         * Measure the OS sleep granularity.
+         * Takes a few milliseconds. Run on construction, it is refined while waiting too.
+         * If sleeps overshoot by more than 4ms, waits spin instead until the granularity wears back down.
+         */
+        void Calibrate();
+
+        /*
+         * Get the time between frames
+         */
+        [[nodiscard]] std::chrono::nanoseconds GetInterval() const;
+
+        /*
+         * Get the measured sleep granularity
+         */
+        [[nodiscard]] std::chrono::nanoseconds GetSleepGranularity() const;
+
+        /*
+         * Get frame time statistics over the recorded history
+         */
+        [[nodiscard]] TFrameTimeStats GetStats() const;
+
+        /*
+         * Forget recorded frames and start a new deadline grid from the next frame
+         */
+        void Reset();
+
+        /*
+         * Set the target FPS.
+         * An FPS of 0 or less does not limit the rate.
+         */
+        void SetTargetFPS(int FPS_);
+
+        /*
+         * End a frame, waiting for its deadline.
+         * If we are more than a frame behind the grid is moved, rather than running frames back to back.
+         */
+        void WaitForNextFrame();
+    };
+}
+
+#endif //FRAMEPACER_H
@@ -12,13 +12,265 @@
 #include "Game.h"
 
 #include "Audio/AudioManager.h"
+#include "Diagnostics/CostTracker.h"
+#include "Diagnostics/Profiler.h"
 #include "Graphics/GraphicsManager.h"
+#include "Graphics/RenderCommandBuffer.h"
+#include "Input/InputState.h"
 #include "Input/Keyboard.h"
 #include "Input/Mouse.h"
 #include "Resources.h"
 #include "WindowManager.h"
 
 namespace NerdThings::Ngine {
+    /*
+     * Update one parallel scene, run as a job.
+     * Anything thrown is kept by the job system and rethrown when the counter is waited on.
+     */
+    static void UpdateParallelScene(void *data_, size_t index_) {
+        static_cast<Scene **>(data_)[index_]->Update();
+    }
+
+    // Private Methods
+
+    void Game::AdvanceSimulation(std::chrono::nanoseconds &lag_, std::chrono::steady_clock::time_point &started_) {
+        // Get the time since we last advanced
+        auto now = std::chrono::steady_clock::now();
+        lag_ += std::chrono::duration_cast<std::chrono::nanoseconds>(now - started_);
+        started_ = now;
+
+        auto timeStep = std::chrono::nanoseconds(1000000000LL / _UpdateFPS);
+        RunUpdates(lag_, timeStep);
+
+        // Draw the leftover time between the last update and the next
+        if (_Config & INTERPOLATE_TRANSFORMS)
+            _InterpolationAlpha = static_cast<float>(lag_.count()) / static_cast<float>(timeStep.count());
+    }
+
+    void Game::Present(const std::function<void()> &draw_) {
+        // Window/Game Size variables
+        const auto w = static_cast<float>(WindowManager::GetWindowWidth());
+        const auto h = static_cast<float>(WindowManager::GetWindowHeight());
+        const auto iw = static_cast<float>(_IntendedWidth);
+        const auto ih = static_cast<float>(_IntendedHeight);
+        const auto scale = std::min(w / iw, h / ih);
+
+        // Prep for drawing
+        Graphics::Drawing::BeginDrawing();
+
+        // Clear
+        Graphics::Drawing::Clear(Graphics::TColor::Black);
+
+        // If using, start using target
+        if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
+            _RenderTarget->Texture->SetTextureWrap(WRAP_CLAMP);
+            _RenderTarget->Texture->SetTextureFilter(RenderTargetFilterMode);
+            Graphics::GraphicsManager::PushTarget(_RenderTarget);
+        }
+
+        // Clear the background
+        Clear();
+
+        // Draw
+        draw_();
+
+        // If using a target, draw target
+        if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
+            auto popped = false;
+            Graphics::GraphicsManager::PopTarget(popped);
+
+            Graphics::Drawing::DrawTexture(_RenderTarget->Texture,
+                                           {
+                                               (w - iw * scale) * 0.5f,
+                                               (h - ih * scale) * 0.5f,
+                                               iw * scale,
+                                               ih * scale
+                                           },
+                                           {
+                                               0,
+                                               0,
+                                               static_cast<float>(_RenderTarget->Texture->Width),
+                                               static_cast<float>(-_RenderTarget->Texture->Height)
+                                           },
+                                           Graphics::TColor::White);
+        }
+
+        // Finish drawing
+        Graphics::Drawing::EndDrawing();
+    }
+
+    void Game::RunPipelined() {
+        // One packet is recorded, one waits to be taken and one is submitted
+        Graphics::RenderCommandBuffer packets[3];
+        auto recording = &packets[0];
+        auto ready = &packets[1];
+        auto submitting = &packets[2];
+        auto packetReady = false;
+
+        std::condition_variable condition;
+        std::mutex mutex;
+        std::exception_ptr error;
+        std::atomic<bool> simulationDone(false);
+
+        // Graphics resources made or freed by the simulation are handed to us
+        Graphics::GraphicsManager::SetJobSystem(_JobSystem.get());
+
+        // Updates run here, and draws are recorded to be submitted by the main thread
+        std::thread simulation([&]() {
+            try {
+                std::chrono::nanoseconds lag(0);
+                auto started = std::chrono::steady_clock::now();
+
+                while (_Running) {
+                    AdvanceSimulation(lag, started);
+
+                    recording->BeginRecording();
+                    try {
+                        Draw();
+                    } catch (...) {
+                        recording->EndRecording();
+                        throw;
+                    }
+                    recording->EndRecording();
+
+                    // Sort here, so the main thread only has to submit
+                    recording->Sort();
+
+                    // Hand the packet over, then stay one frame ahead of the main thread
+                    std::unique_lock<std::mutex> lock(mutex);
+                    std::swap(recording, ready);
+                    packetReady = true;
+                    condition.notify_all();
+                    condition.wait(lock, [&]() { return !packetReady || !_Running; });
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+                _Running = false;
+                condition.notify_all();
+            }
+
+            simulationDone = true;
+        });
+
+        EventArgs args;
+        while (!WindowManager::ShouldClose() && _Running) {
+            ScaleMouse(true);
+
+            // Run anything the simulation has handed back to us
+            _JobSystem->RunMainThreadJobs();
+
+            // Devices are polled here, so their events fire on the main thread
+            Input::Mouse::OnGameUpdate(args);
+            Audio::AudioManager::Update(args);
+
+            {
+                std::lock_guard<std::mutex> lock(_PipelineInputMutex);
+                _PipelineInput.Accumulate(Input::TInputState::Capture());
+            }
+
+            // Take the newest packet, or draw the last one again
+            bool take;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                take = packetReady;
+            }
+
+            if (take) {
+                // Free the old packet's resources here, they may be the last references to GL resources
+                submitting->Clear();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                std::swap(ready, submitting);
+                packetReady = false;
+                condition.notify_all();
+            }
+
+            Present([submitting]() {
+                Graphics::Drawing::DrawCommandBuffer(*submitting);
+            });
+
+            ScaleMouse(false);
+
+            // Wait for the next frame
+            _FramePacer.WaitForNextFrame();
+        }
+
+        // Stop the simulation
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            _Running = false;
+            condition.notify_all();
+        }
+
+        // The simulation may be waiting on us to make a resource
+        while (!simulationDone) {
+            _JobSystem->RunMainThreadJobs();
+            std::this_thread::yield();
+        }
+        simulation.join();
+
+        Graphics::GraphicsManager::SetJobSystem(nullptr);
+
+        if (error != nullptr)
+            std::rethrow_exception(error);
+    }
+
+    void Game::RunUpdates(std::chrono::nanoseconds &lag_, std::chrono::nanoseconds timeStep_) {
+        auto started = std::chrono::steady_clock::now();
+        unsigned int updates = 0;
+
+        while (lag_ >= timeStep_ && _Running) {
+            if (_MaxUpdatesPerFrame > 0 && updates >= _MaxUpdatesPerFrame)
+                break;
+
+            // If updates take longer than the time they simulate, catching up only puts us further behind
+            if (updates > 0 && std::chrono::steady_clock::now() - started > timeStep_ * updates)
+                break;
+
+            lag_ -= timeStep_;
+            Update();
+            updates++;
+        }
+
+        // Drop the steps we gave up on, keeping the partial step
+        if (lag_ >= timeStep_ && _Running) {
+            auto dropped = lag_ - lag_ % timeStep_;
+            lag_ -= dropped;
+            _DroppedSimulationTime += dropped;
+            OnSimulationTimeDropped({dropped, updates});
+        }
+    }
+
+    void Game::ScaleMouse(bool scale_) {
+        if (!(_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0))
+            return;
+
+        if (scale_) {
+            const auto w = static_cast<float>(WindowManager::GetWindowWidth());
+            const auto h = static_cast<float>(WindowManager::GetWindowHeight());
+            const auto iw = static_cast<float>(_IntendedWidth);
+            const auto ih = static_cast<float>(_IntendedHeight);
+            const auto scale = std::min(w / iw, h / ih);
+            const auto offsetX = (w - iw * scale) * 0.5f;
+            const auto offsetY = (h - ih * scale) * 0.5f;
+
+            Input::Mouse::SetScale(iw / (w - offsetX * 2.0f), ih / (h - offsetY * 2.0f));
+            Input::Mouse::SetOffset(-offsetX, -offsetY);
+        } else {
+            Input::Mouse::SetScale(1, 1);
+            Input::Mouse::SetOffset(0, 0);
+        }
+    }
+
+    void Game::Start() {
+        if (_Started)
+            return;
+
+        _Started = true;
+        OnRun({});
+    }
+
     // Public Constructor(s)
 
     Game::Game(const int width_, const int height_, const int FPS_, const std::string &title_, int config_)
@@ -30,19 +282,30 @@ namespace NerdThings::Ngine {
 
     Game::Game(int windowWidth_, int windowHeight_, int targetWidth_, int targetHeight_, int drawFPS_, int updateFPS_,
                const std::string &title_, int config_) {
-        #if !defined(PLATFORM_UWP)
+        // Start worker threads
+        _JobSystem = std::make_unique<Threading::JobSystem>();
 
         // Save config
         _Config = config_;
 
-        // Apply raylib config
-        WindowManager::ApplyConfig(_Config);
-        ConsoleMessage("Window config has been applied.", "NOTICE", "GAME");
-
         // Set intended dimensions
         _IntendedHeight = targetHeight_;
         _IntendedWidth = targetWidth_;
 
+        // No window, no devices, only updates
+        if (IsHeadless()) {
+            _DrawFPS = drawFPS_;
+            SetUpdateFPS(updateFPS_);
+            ConsoleMessage("Running headless.", "NOTICE", "GAME");
+            return;
+        }
+
+        #if !defined(PLATFORM_UWP)
+
+        // Apply raylib config
+        WindowManager::ApplyConfig(_Config);
+        ConsoleMessage("Window config has been applied.", "NOTICE", "GAME");
+
         // Initialize raylib's window
         WindowManager::Init(windowWidth_, windowHeight_, title_);
         ConsoleMessage("Window has been initialized.", "NOTICE", "GAME");
@@ -51,10 +314,12 @@ namespace NerdThings::Ngine {
         SetDrawFPS(drawFPS_);
         SetUpdateFPS(updateFPS_);
 
-        // Register default events
+        // Register default events, pipelined games poll devices on the main thread instead
         OnRun.Bind(Input::Mouse::OnGameRun);
-        OnUpdate.Bind(Input::Mouse::OnGameUpdate);
-        OnUpdate.Bind(Audio::AudioManager::Update);
+        if (!IsPipelined()) {
+            OnUpdate.Bind(Input::Mouse::OnGameUpdate);
+            OnUpdate.Bind(Audio::AudioManager::Update);
+        }
         ConsoleMessage("Engine events have been registered.", "NOTICE", "GAME");
 
         // By default, disable exit key
@@ -69,10 +334,50 @@ namespace NerdThings::Ngine {
 
     // Public Methods
 
+    void Game::AddParallelScene(Scene *scene_) {
+        if (scene_ == nullptr) {
+            ConsoleMessage("Attempted to add a null parallel scene.", "FATAL", "GAME");
+            throw std::runtime_error("Cannot add a null parallel scene.");
+        }
+
+        if (_UpdatingParallelScenes) {
+            ConsoleMessage("Attempted to add a parallel scene while parallel scenes are updating.", "FATAL", "GAME");
+            throw std::runtime_error("Cannot add a parallel scene while parallel scenes are updating.");
+        }
+
+        if (scene_ == _CurrentScene || std::find(_ParallelScenes.begin(), _ParallelScenes.end(), scene_) != _ParallelScenes.end()) {
+            ConsoleMessage("Attempted to add a scene that is already being updated.", "FATAL", "GAME");
+            throw std::runtime_error("A scene cannot be updated twice.");
+        }
+
+        _ParallelScenes.push_back(scene_);
+        scene_->OnLoad({this});
+
+        ConsoleMessage("A parallel scene has been added.", "NOTICE", "GAME");
+    }
+
+    void Game::DispatchEventQueues() {
+        // Take a snapshot so handlers can create queues
+        {
+            std::lock_guard<std::mutex> lock(_EventQueuesMutex);
+            _EventQueuesDispatching.clear();
+            for (const auto &queue : _EventQueues) {
+                if (queue != nullptr)
+                    _EventQueuesDispatching.push_back(queue.get());
+            }
+        }
+
+        for (auto queue : _EventQueuesDispatching) {
+            queue->Dispatch();
+        }
+    }
+
     void Game::Draw() {
+        NGINE_PROFILE_SCOPE("Game::Draw");
+
         if (_CurrentScene != nullptr) {
             OnDraw({});
-            _CurrentScene->Draw();
+            _CurrentScene->Draw(_InterpolationAlpha);
         }
     }
 
@@ -84,6 +389,14 @@ namespace NerdThings::Ngine {
         return { (float)_IntendedWidth, (float)_IntendedHeight };
     }
 
+    std::chrono::nanoseconds Game::GetDroppedSimulationTime() const {
+        return _DroppedSimulationTime;
+    }
+
+    TFrameTimeStats Game::GetFrameTimeStats() const {
+        return _FramePacer.GetStats();
+    }
+
     int Game::GetDrawFPS() const {
         return _DrawFPS;
     }
@@ -92,11 +405,61 @@ namespace NerdThings::Ngine {
         return _UpdateFPS;
     }
 
+    unsigned int Game::GetMaxUpdatesPerFrame() const {
+        return _MaxUpdatesPerFrame;
+    }
+
+    const std::vector<Scene *> &Game::GetParallelScenes() const {
+        return _ParallelScenes;
+    }
+
+    Threading::JobSystem &Game::GetJobSystem() {
+        return *_JobSystem;
+    }
+
+    bool Game::GetUncappedUpdates() const {
+        return _UncappedUpdates;
+    }
+
+    bool Game::IsHeadless() const {
+        return (_Config & HEADLESS) > 0;
+    }
+
+    bool Game::IsPipelined() const {
+        return (_Config & PIPELINED) > 0 && !IsHeadless();
+    }
+
     void Game::Quit() {
         _Running = false;
     }
 
     void Game::Run() {
+        if (IsHeadless()) {
+            Start();
+            _Running = true;
+
+            // Timing
+            std::chrono::nanoseconds lag(0);
+            auto started = std::chrono::steady_clock::now();
+
+            while (_Running) {
+                _JobSystem->RunMainThreadJobs();
+
+                if (_UncappedUpdates) {
+                    Update();
+                    continue;
+                }
+
+                AdvanceSimulation(lag, started);
+
+                // Wait for the next update
+                _FramePacer.WaitForNextFrame();
+            }
+
+            ConsoleMessage("Game successfully shut down.", "NOTICE", "GAME");
+            return;
+        }
+
         #if !defined(PLATFORM_UWP)
 
         // Create render target
@@ -104,13 +467,6 @@ namespace NerdThings::Ngine {
             _RenderTarget = std::make_shared<Graphics::TRenderTarget>(_IntendedWidth, _IntendedHeight);
         }
 
-        // Timing
-        std::chrono::nanoseconds lag(0);
-        auto started = std::chrono::high_resolution_clock::now();
-
-        auto lastFPS = _UpdateFPS;
-        auto timeStep = std::chrono::milliseconds(int(1.0f / float(lastFPS) * 1000.0f));
-
         // Init audio
         ConsoleMessage("Attempting to initialize audio device.", "NOTICE", "GAME");
         Audio::AudioManager::InitDevice();
@@ -123,100 +479,36 @@ namespace NerdThings::Ngine {
         }
 
         // Invoke OnRun
-        OnRun({});
+        Start();
 
         _Running = true;
 
-        while (!WindowManager::ShouldClose() && _Running) {
-            // Window/Game Size variables
-            const auto w = static_cast<float>(WindowManager::GetWindowWidth());
-            const auto h = static_cast<float>(WindowManager::GetWindowHeight());
-            const auto iw = static_cast<float>(_IntendedWidth);
-            const auto ih = static_cast<float>(_IntendedHeight);
-            const auto scale = std::min(w / iw, h / ih);
-            const auto offsetX = (w - iw * scale) * 0.5;
-            const auto offsetY = (h - ih * scale) * 0.5;
-
-            // Get the time since the last frame
-            auto deltaTime = std::chrono::high_resolution_clock::now() - started;
-            started = std::chrono::high_resolution_clock::now();
-            lag += std::chrono::duration_cast<std::chrono::nanoseconds>(deltaTime);
-
-            // Update timestep if FPS has changed
-            if (_UpdateFPS != lastFPS) {
-                lastFPS = _UpdateFPS;
-                timeStep = std::chrono::milliseconds(int(1.0f / float(lastFPS) * 1000.0f));
-
-                ConsoleMessage("Timestep updated to match FPS.", "NOTICE", "GAME");
-            }
-
-            // Setup mouse
-            if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
-                Input::Mouse::SetScale(iw / (w - offsetX * 2.0f), ih / (h - offsetY * 2.0f));
-                Input::Mouse::SetOffset(-offsetX, -offsetY);
-            }
+        if (IsPipelined()) {
+            RunPipelined();
+        } else {
+            // Timing
+            std::chrono::nanoseconds lag(0);
+            auto started = std::chrono::steady_clock::now();
 
-            // Skip if we are going to catch up more than 5 seconds, that is too much (May not fix what I am experiencing)
-            if (lag.count() >= 5e+9) lag = std::chrono::nanoseconds(0);
+            while (!WindowManager::ShouldClose() && _Running) {
+                ScaleMouse(true);
 
-            // Run Updates
-            while (lag >= timeStep) {
-                // Run a single update
-                lag -= timeStep;
-                Update();
-            }
+                // Run anything jobs have handed back to us
+                _JobSystem->RunMainThreadJobs();
 
-            // Prep for drawing
-            Graphics::Drawing::BeginDrawing();
+                // Run Updates
+                AdvanceSimulation(lag, started);
 
-            // Clear
-            Graphics::Drawing::Clear(Graphics::TColor::Black);
+                // Draw
+                Present([this]() {
+                    Draw();
+                });
 
-            // If using, start using target
-            if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
-                _RenderTarget->Texture->SetTextureWrap(WRAP_CLAMP);
-                _RenderTarget->Texture->SetTextureFilter(RenderTargetFilterMode);
-                Graphics::GraphicsManager::PushTarget(_RenderTarget);
-            }
+                ScaleMouse(false);
 
-            // Clear the background
-            Clear();
-
-            // Draw
-            Draw();
-
-            // If using a target, draw target
-            if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
-                auto popped = false;
-                Graphics::GraphicsManager::PopTarget(popped);
-
-                Graphics::Drawing::DrawTexture(_RenderTarget->Texture,
-                                               {
-                                                   (w - iw * scale) * 0.5f,
-                                                   (h - ih * scale) * 0.5f,
-                                                   iw * scale,
-                                                   ih * scale
-                                               },
-                                               {
-                                                   0,
-                                                   0,
-                                                   static_cast<float>(_RenderTarget->Texture->Width),
-                                                   static_cast<float>(-_RenderTarget->Texture->Height)
-                                               },
-                                               Graphics::TColor::White);
+                // Wait for the next frame
+                _FramePacer.WaitForNextFrame();
             }
-
-            // Reset mouse
-            if (_Config & MAINTAIN_DIMENSIONS && _RenderTarget->ID > 0) {
-                Input::Mouse::SetScale(1, 1);
-                Input::Mouse::SetOffset(0, 0);
-            }
-
-            // Finish drawing
-            Graphics::Drawing::EndDrawing();
-
-            // Release thread to CPU (Stops weird idle cpu usage and fps drops)
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
 
         // Delete render target now so that it doesnt try after GL is gone.
@@ -242,18 +534,58 @@ namespace NerdThings::Ngine {
         #endif
     }
 
+    void Game::RemoveParallelScene(Scene *scene_) {
+        if (_UpdatingParallelScenes) {
+            ConsoleMessage("Attempted to remove a parallel scene while parallel scenes are updating.", "FATAL", "GAME");
+            throw std::runtime_error("Cannot remove a parallel scene while parallel scenes are updating.");
+        }
+
+        auto it = std::find(_ParallelScenes.begin(), _ParallelScenes.end(), scene_);
+        if (it == _ParallelScenes.end())
+            return;
+
+        _ParallelScenes.erase(it);
+        scene_->OnUnLoad({this});
+
+        ConsoleMessage("A parallel scene has been removed.", "NOTICE", "GAME");
+    }
+
+    void Game::RunTicks(unsigned int ticks_) {
+        Start();
+        _Running = true;
+
+        for (unsigned int i = 0; i < ticks_ && _Running; i++) {
+            _JobSystem->RunMainThreadJobs();
+            Update();
+        }
+
+        _Running = false;
+    }
+
     void Game::SetFPS(int FPS_) {
-        _UpdateFPS = FPS_;
-        _DrawFPS = FPS_;
-        WindowManager::SetTargetFPS(FPS_);
+        SetUpdateFPS(FPS_);
+        SetDrawFPS(FPS_);
     }
 
     void Game::SetDrawFPS(int FPS_) {
         _DrawFPS = FPS_;
-        WindowManager::SetTargetFPS(FPS_);
+        if (!IsHeadless()) {
+            // We pace frames ourselves, so raylib should not wait as well
+            _FramePacer.SetTargetFPS(FPS_);
+            WindowManager::SetTargetFPS(0);
+        }
+    }
+
+    void Game::SetMaxUpdatesPerFrame(unsigned int max_) {
+        _MaxUpdatesPerFrame = max_;
     }
 
     void Game::SetScene(Scene *scene_) {
+        if (scene_ != nullptr && std::find(_ParallelScenes.begin(), _ParallelScenes.end(), scene_) != _ParallelScenes.end()) {
+            ConsoleMessage("Attempted to set a parallel scene as the current scene.", "FATAL", "GAME");
+            throw std::runtime_error("A scene cannot be updated twice.");
+        }
+
         if (_CurrentScene != nullptr)
             _CurrentScene->OnUnLoad({this});
 
@@ -265,17 +597,75 @@ namespace NerdThings::Ngine {
         ConsoleMessage("A new scene has been loaded.", "NOTICE", "GAME");
     }
 
+    void Game::SetUncappedUpdates(bool uncapped_) {
+        _UncappedUpdates = uncapped_;
+    }
+
     void Game::SetUpdateFPS(int FPS_) {
         _UpdateFPS = FPS_;
+        if (IsHeadless())
+            _FramePacer.SetTargetFPS(FPS_);
     }
 
     void Game::Update() {
+#if defined(NGINE_PROFILER)
+        // Each update starts a profiler frame, the draws since the last update belong to the previous one
+        Diagnostics::Profiler::NextFrame();
+        Diagnostics::CostTracker::NextFrame();
+#endif
+        NGINE_PROFILE_SCOPE("Game::Update");
+
         // Run update events
         OnUpdate({});
 
-        if (_CurrentScene != nullptr) {
-            _CurrentScene->Update();
+        // Deliver events posted since the last update
+        DispatchEventQueues();
+
+        // Start the parallel scenes, they update on workers alongside the current scene
+        Threading::TJobCounter parallelCounter;
+        if (!_ParallelScenes.empty()) {
+            Threading::TJob job;
+            job.Function = &UpdateParallelScene;
+            job.Data = _ParallelScenes.data();
+
+            _UpdatingParallelScenes = true;
+            _JobSystem->Schedule(job, _ParallelScenes.size(), parallelCounter);
+        }
+
+        try {
+            if (IsPipelined()) {
+                // Hand over the input gathered by the main thread since the last update
+                std::lock_guard<std::mutex> lock(_PipelineInputMutex);
+                if (_CurrentScene != nullptr)
+                    _CurrentScene->SetInput(_PipelineInput);
+                _PipelineInput.ClearEdges();
+            } else if (!IsHeadless() && _CurrentScene != nullptr) {
+                _CurrentScene->SetInput(Input::TInputState::Capture());
+            }
+
+            if (_CurrentScene != nullptr)
+                _CurrentScene->Update();
+        } catch (...) {
+            // The parallel scenes still reference the counter. If one of them threw too, ours wins.
+            try {
+                _JobSystem->Wait(parallelCounter);
+            } catch (...) {}
+            _UpdatingParallelScenes = false;
+            throw;
         }
+
+        // Wait for the parallel scenes, helping out with them if they are behind.
+        // If one threw, this rethrows once they have all finished.
+        try {
+            _JobSystem->Wait(parallelCounter);
+        } catch (...) {
+            _UpdatingParallelScenes = false;
+            throw;
+        }
+        _UpdatingParallelScenes = false;
+
+        // Deliver events posted by the scene
+        DispatchEventQueues();
     }
 
     // Protected Methods
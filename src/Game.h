@@ -14,13 +14,22 @@
 
 #include "ngine.h"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 #include "Graphics/Color.h"
 #include "Graphics/Drawing.h"
 #include "Graphics/RenderTarget.h"
+#include "Input/InputState.h"
+#include "Threading/JobSystem.h"
 #include "Resources.h"
 #include "Vector2.h"
 #include "EventHandler.h"
+#include "EventQueue.h"
+#include "FramePacer.h"
 #include "Scene.h"
+#include "TypeID.h"
 
 namespace NerdThings::Ngine {
     /*
@@ -44,6 +53,36 @@ namespace NerdThings::Ngine {
          */
         int _DrawFPS = 0;
 
+        /*
+         * Total simulation time dropped
+         */
+        std::chrono::nanoseconds _DroppedSimulationTime{0};
+
+        /*
+         * Event queues, indexed by event TypeID
+         */
+        std::vector<std::unique_ptr<IEventQueue>> _EventQueues;
+
+        /*
+         * Lock for _EventQueues
+         */
+        std::mutex _EventQueuesMutex;
+
+        /*
+         * Scratch list of queues to dispatch
+         */
+        std::vector<IEventQueue *> _EventQueuesDispatching;
+
+        /*
+         * Paces draws, or updates when headless
+         */
+        FramePacer _FramePacer;
+
+        /*
+         * How far between the last two updates the next draw is
+         */
+        float _InterpolationAlpha = 1;
+
         /*
          * The intended game height
          */
@@ -54,6 +93,31 @@ namespace NerdThings::Ngine {
          */
         int _IntendedWidth = 0;
 
+        /*
+         * The job system
+         */
+        std::unique_ptr<Threading::JobSystem> _JobSystem;
+
+        /*
+         * The most updates run to catch up in one frame, 0 for no limit
+         */
+        unsigned int _MaxUpdatesPerFrame = 5;
+
+        /*
+         * Scenes updated in parallel alongside the current scene
+         */
+        std::vector<Scene *> _ParallelScenes;
+
+        /*
+         * Input gathered by the main thread for the next update, when pipelined
+         */
+        Input::TInputState _PipelineInput;
+
+        /*
+         * Lock for _PipelineInput
+         */
+        std::mutex _PipelineInputMutex;
+
         /*
          * The render target used for enforcing resolution
          */
@@ -62,13 +126,63 @@ namespace NerdThings::Ngine {
         /*
          * Is the game loop running
          */
-        bool _Running = false;
+        std::atomic<bool> _Running{false};
+
+        /*
+         * Whether or not OnRun has been invoked
+         */
+        bool _Started = false;
+
+        /*
+         * Whether or not parallel scenes are updating
+         */
+        bool _UpdatingParallelScenes = false;
+
+        /*
+         * Whether or not updates run back to back, ignoring the update FPS
+         */
+        bool _UncappedUpdates = false;
 
         /*
          * The target update FPS
          */
         int _UpdateFPS = 0;
 
+        // Private Methods
+
+        /*
+         * Add the time since started_ to the lag and run the updates due
+         */
+        void AdvanceSimulation(std::chrono::nanoseconds &lag_, std::chrono::steady_clock::time_point &started_);
+
+        /*
+         * Draw a frame to the window, through the render target if we have one
+         */
+        void Present(const std::function<void()> &draw_);
+
+        /*
+         * The pipelined game loop.
+         * A simulation thread updates and records frame packets, we submit them.
+         */
+        void RunPipelined();
+
+        /*
+         * Run updates to consume lag.
+         * Stops at the update cap, or once updates take longer than the time they simulate,
+         * and drops whatever whole steps are left.
+         */
+        void RunUpdates(std::chrono::nanoseconds &lag_, std::chrono::nanoseconds timeStep_);
+
+        /*
+         * Scale the mouse to the render target, or reset it
+         */
+        void ScaleMouse(bool scale_);
+
+        /*
+         * Invoke OnRun if we haven't yet
+         */
+        void Start();
+
     public:
         // Public Fields
 
@@ -87,6 +201,12 @@ namespace NerdThings::Ngine {
          */
         EventHandler<EventArgs> OnRun;
 
+        /*
+         * On simulation time dropped event.
+         * Fired when the game falls too far behind to catch up, the time is skipped rather than updated.
+         */
+        EventHandler<SimulationTimeDroppedEventArgs> OnSimulationTimeDropped;
+
         /*
          * On update event
          */
@@ -121,6 +241,20 @@ namespace NerdThings::Ngine {
 
         // Public Methods
 
+        /*
+         * Add a scene to be updated in parallel.
+         * Parallel scenes update on the job system at the same time as the current scene, and are never drawn.
+         * They must not share entities or make raylib calls while updating, so this is mainly for headless games
+         * running many independent simulations. Input must be given to each with Scene::SetInput.
+         */
+        void AddParallelScene(Scene *scene_);
+
+        /*
+         * Dispatch all event queues.
+         * This is run before and after the scene update.
+         */
+        void DispatchEventQueues();
+
         /*
          * Draw a frame.
          */
@@ -137,16 +271,78 @@ namespace NerdThings::Ngine {
          */
         TVector2 GetDimensions() const;
 
+        /*
+         * Get the queue for an event type, creating it if needed.
+         * Thread safe. The queue lives as long as the game, so the reference can be kept.
+         */
+        template <typename EventType>
+        EventQueue<EventType> &GetEventQueue() {
+            auto id = TypeID::Get<EventType>();
+
+            std::lock_guard<std::mutex> lock(_EventQueuesMutex);
+
+            if (id >= _EventQueues.size())
+                _EventQueues.resize(id + 1);
+
+            auto &queue = _EventQueues[id];
+            if (queue == nullptr)
+                queue = std::make_unique<EventQueue<EventType>>();
+
+            return *static_cast<EventQueue<EventType> *>(queue.get());
+        }
+
+        /*
+         * Get the total simulation time dropped because the game could not keep up
+         */
+        [[nodiscard]] std::chrono::nanoseconds GetDroppedSimulationTime() const;
+
+        /*
+         * Get frame time statistics over recent frames.
+         * Frames are draws, or updates when headless.
+         */
+        [[nodiscard]] TFrameTimeStats GetFrameTimeStats() const;
+
         /*
          * Get the target draw FPS.
          */
         [[nodiscard]] int GetDrawFPS() const;
 
+        /*
+         * Get the most updates run to catch up in one frame
+         */
+        [[nodiscard]] unsigned int GetMaxUpdatesPerFrame() const;
+
+        /*
+         * Get the scenes updated in parallel
+         */
+        [[nodiscard]] const std::vector<Scene *> &GetParallelScenes() const;
+
         /*
          * Get the target update FPS.
          */
         [[nodiscard]] int GetUpdateFPS() const;
 
+        /*
+         * Get the job system.
+         * Jobs must not make raylib calls, use JobSystem::RunOnMainThread for those.
+         */
+        Threading::JobSystem &GetJobSystem();
+
+        /*
+         * Get whether or not updates run back to back
+         */
+        [[nodiscard]] bool GetUncappedUpdates() const;
+
+        /*
+         * Whether or not the game is running headless
+         */
+        [[nodiscard]] bool IsHeadless() const;
+
+        /*
+         * Whether or not updates and draws are pipelined with rendering
+         */
+        [[nodiscard]] bool IsPipelined() const;
+
         /*
          * Quit the game
          */
@@ -157,6 +353,18 @@ namespace NerdThings::Ngine {
          */
         void Run();
 
+        /*
+         * Remove a parallel scene.
+         * Cannot be called while parallel scenes are updating.
+         */
+        void RemoveParallelScene(Scene *scene_);
+
+        /*
+         * Run a number of updates as fast as possible, without drawing.
+         * Stops early if Quit is called. Intended for headless simulation and tests.
+         */
+        void RunTicks(unsigned int ticks_);
+
         /*
          * Set the target FPS.
          * If using advanced game, this will set both update and draw FPS
@@ -174,11 +382,23 @@ namespace NerdThings::Ngine {
          */
         void SetIntendedSize(TVector2 size_);
 
+        /*
+         * Set the most updates run to catch up in one frame.
+         * Lag beyond this is dropped, firing OnSimulationTimeDropped. 0 for no limit.
+         */
+        void SetMaxUpdatesPerFrame(unsigned int max_);
+
         /*
          * Set the current scene
          */
         void SetScene(Scene *scene_);
 
+        /*
+         * Set whether or not updates run back to back, ignoring the update FPS.
+         * Only applies to headless games, where it runs simulation faster than real time.
+         */
+        void SetUncappedUpdates(bool uncapped_);
+
         /*
          * Set the target update FPS
          */
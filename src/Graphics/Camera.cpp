@@ -11,7 +11,7 @@
 
 #include "Camera.h"
 
-#include <rlgl.h>
+#include "Drawing.h"
 
 namespace NerdThings::Ngine::Graphics {
     // Public Methods
@@ -41,16 +41,14 @@ namespace NerdThings::Ngine::Graphics {
     #endif
 
     void TCamera::BeginCamera() const {
-        EndMode2D(); //Ironic, isn't it.
-
-        // This works how we want, raylib's doesn't work as well
-        auto mat = GetTranslationMatrix();
-
-        rlMultMatrixf(MatrixToFloat(*reinterpret_cast<Matrix*>(&mat))); //Hacky, but sure
+        auto &buffer = Drawing::GetCommandBuffer();
+        TRenderCommand command(COMMAND_BEGIN_CAMERA);
+        command.Offset = buffer.AddMatrix(GetTranslationMatrix());
+        Drawing::AddCommand(buffer, command);
     }
 
     void TCamera::EndCamera() const {
-        EndMode2D();
+        Drawing::AddCommand(Drawing::GetCommandBuffer(), TRenderCommand(COMMAND_END_CAMERA));
     }
 
     TVector2 TCamera::ScreenToWorld(TVector2 pos_) {
@@ -11,6 +11,7 @@
 
 #include "Canvas.h"
 
+#include "../Diagnostics/Profiler.h"
 #include "Drawing.h"
 #include "GraphicsManager.h"
 
@@ -19,13 +20,17 @@ namespace NerdThings::Ngine::Graphics {
 
     Canvas::Canvas(float width_, float height_)
             : _Width(width_), _Height(height_) {
-        _RenderTarget = std::make_shared<TRenderTarget>(_Width, _Height);
+        // Render targets must be made with the graphics context
+        GraphicsManager::RunOnMainThread([&]() {
+            _RenderTarget = std::make_shared<TRenderTarget>(_Width, _Height);
+        });
     }
 
     // Destructor
 
     Canvas::~Canvas() {
         ConsoleMessage("Deleting canvas.", "NOTICE", "CANVAS");
+        GraphicsManager::ReleaseOnMainThread(std::move(_RenderTarget));
     }
 
     // Public Methods
@@ -56,18 +61,30 @@ namespace NerdThings::Ngine::Graphics {
     }
 
     void Canvas::ReDraw() {
-        Graphics::GraphicsManager::PushTarget(_RenderTarget);
-        Graphics::Drawing::Clear(TColor::Transparent);
-        RenderTargetRedraw();
-        bool popped = false;
-        Graphics::GraphicsManager::PopTarget(popped);
+        NGINE_PROFILE_SCOPE("Canvas::ReDraw");
+
+        auto redraw = [&]() {
+            Graphics::GraphicsManager::PushTarget(_RenderTarget);
+            Graphics::Drawing::Clear(TColor::Transparent);
+            RenderTargetRedraw();
+            bool popped = false;
+            Graphics::GraphicsManager::PopTarget(popped);
+        };
+
+        // Outside of a frame this draws straight away, so it must be done with the graphics context
+        if (RenderCommandBuffer::GetRecording() == nullptr)
+            GraphicsManager::RunOnMainThread(redraw);
+        else
+            redraw();
     }
 
     void Canvas::SetDimensions(float width_, float height_) {
         ConsoleMessage("Resizing canvas.", "NOTICE", "CANVAS");
         _Width = width_;
         _Height = height_;
-        _RenderTarget = std::make_shared<TRenderTarget>(_Width, _Height);
+        GraphicsManager::RunOnMainThread([&]() {
+            _RenderTarget = std::make_shared<TRenderTarget>(_Width, _Height);
+        });
         ReDraw();
     }
 }
\ No newline at end of file
@@ -11,131 +11,180 @@
 
 #include "Drawing.h"
 
-#include <rlgl.h>
-
 // TODO: Use rlgl to add custom vertex data support (i.e. custom shapes)
 
 namespace NerdThings::Ngine::Graphics {
+    /*
+     * Takes commands drawn outside of a frame, which run as soon as they are added.
+     * Kept out of the class, as thread local data cannot be exported from a DLL.
+     */
+    static thread_local RenderCommandBuffer ImmediateBuffer;
+
+    /*
+     * Get the ID of a font's texture, for batching
+     */
+    static unsigned int GetFontTextureID(const std::shared_ptr<TFont> &font_) {
+        return font_->Texture != nullptr ? font_->Texture->ID : 0;
+    }
+
+    // Private Fields
+
+    std::shared_ptr<IRenderBackend> Drawing::_Backend = std::make_shared<RaylibRenderBackend>();
+
+    RenderCommandBuffer Drawing::_FrameBuffer;
+
     // Public Methods
 
+    void Drawing::AddCommand(RenderCommandBuffer &buffer_, const TRenderCommand &command_) {
+        buffer_.Add(command_);
+
+        if (&buffer_ == &ImmediateBuffer) {
+            buffer_.Submit(*_Backend);
+            _Backend->Finish();
+            buffer_.Clear();
+        }
+    }
+
     void Drawing::BeginDrawing() {
         ::BeginDrawing();
+        _FrameBuffer.BeginRecording();
     }
 
     void Drawing::Clear(const TColor color_) {
-        auto c = color_.ToRaylibColor();
-        ClearBackground(color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CLEAR);
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
+    }
+
+    void Drawing::DrawCommandBuffer(const RenderCommandBuffer &buffer_) {
+        // Not owned, the caller keeps it alive until the frame is submitted
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_EXECUTE_BUFFER);
+        command.Resources[0] = buffer.AddResource(std::shared_ptr<void>(std::shared_ptr<void>(), const_cast<RenderCommandBuffer *>(&buffer_)));
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawPixel(const TVector2 position_, const TColor color_) {
-        DrawPixelV(position_.ToRaylibVec(),
-                   color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_PIXEL);
+        command.Points[0] = position_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
 
     void Drawing::DrawLine(const TVector2 startPos_, const TVector2 endPos_, const TColor color_,
                            const float thickness_) {
-        DrawLineEx(startPos_.ToRaylibVec(),
-                   endPos_.ToRaylibVec(),
-                   thickness_,
-                   color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_LINE);
+        command.Points[0] = startPos_;
+        command.Points[1] = endPos_;
+        command.Values[0] = thickness_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawLineStrip(std::vector<TVector2> points_, const TColor color_) {
-        //Build points array
-        auto pts = new Vector2[points_.size()];
-        for (unsigned int i = 0; i < points_.size(); i++) {
-            pts[i] = points_[i].ToRaylibVec();
-        }
-
-        //Draw
-        ::DrawLineStrip(pts,
-                        points_.size(),
-                        color_.ToRaylibColor());
-
-        //Delete points array
-        delete[] pts;
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_LINE_STRIP);
+        command.Offset = buffer.AddVertices(points_);
+        command.Count = static_cast<unsigned int>(points_.size());
+        command.Colors[0] = color_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawLineBezier(const TVector2 startPos_, const TVector2 endPos_, const TColor color_,
                                  const float thickness_) {
-        ::DrawLineBezier(startPos_.ToRaylibVec(),
-                         endPos_.ToRaylibVec(),
-                         thickness_,
-                         color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_LINE_BEZIER);
+        command.Points[0] = startPos_;
+        command.Points[1] = endPos_;
+        command.Values[0] = thickness_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawCircle(const TVector2 center_, const float radius_, const TColor color_) {
-        DrawCircleV(center_.ToRaylibVec(),
-                    radius_,
-                    color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CIRCLE);
+        command.Points[0] = center_;
+        command.Values[0] = radius_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawCircleGradient(const TVector2 center_, const float radius_, const TColor color1_,
                                      const TColor color2_) {
-        ::DrawCircleGradient(static_cast<int>(center_.X),
-                             static_cast<int>(center_.Y),
-                             radius_,
-                             color1_.ToRaylibColor(),
-                             color2_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CIRCLE_GRADIENT);
+        command.Points[0] = center_;
+        command.Values[0] = radius_;
+        command.Colors[0] = color1_;
+        command.Colors[1] = color2_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawCircleLines(const TVector2 center_, const float radius_, const TColor color_) {
-        ::DrawCircleLines(static_cast<int>(center_.X),
-                          static_cast<int>(center_.Y),
-                          radius_,
-                          color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CIRCLE_LINES);
+        command.Points[0] = center_;
+        command.Values[0] = radius_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawCircleSector(const TVector2 center_, const float radius_, const int startAngle_,
                                    const int endAngle_, const int segments_,
                                    const TColor color_) {
-        ::DrawCircleSector(center_.ToRaylibVec(),
-                           radius_,
-                           startAngle_,
-                           endAngle_,
-                           segments_,
-                           color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CIRCLE_SECTOR);
+        command.Points[0] = center_;
+        command.Values[0] = radius_;
+        command.Integers[0] = startAngle_;
+        command.Integers[1] = endAngle_;
+        command.Integers[2] = segments_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawCircleSectorLines(const TVector2 center_, const float radius_, const int startAngle_,
                                         const int endAngle_, const int segments_,
                                         const TColor color_) {
-        ::DrawCircleSectorLines(center_.ToRaylibVec(),
-                                radius_,
-                                startAngle_,
-                                endAngle_,
-                                segments_,
-                                color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_CIRCLE_SECTOR_LINES);
+        command.Points[0] = center_;
+        command.Values[0] = radius_;
+        command.Integers[0] = startAngle_;
+        command.Integers[1] = endAngle_;
+        command.Integers[2] = segments_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawFPS(const TVector2 position_) {
-        ::DrawFPS(static_cast<int>(position_.X),
-                  static_cast<int>(position_.Y));
+        TRenderCommand command(COMMAND_FPS);
+        command.Points[0] = position_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRing(const TVector2 center_, const float innerRadius_, const float outerRadius_,
                            const int startAngle_, const int endAngle_,
                            const int segments_, const TColor color_) {
-        ::DrawRing(center_.ToRaylibVec(),
-                   innerRadius_,
-                   outerRadius_,
-                   startAngle_,
-                   endAngle_,
-                   segments_,
-                   color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RING);
+        command.Points[0] = center_;
+        command.Values[0] = innerRadius_;
+        command.Values[1] = outerRadius_;
+        command.Integers[0] = startAngle_;
+        command.Integers[1] = endAngle_;
+        command.Integers[2] = segments_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRingLines(const TVector2 center_, const float innerRadius_, const float outerRadius_,
                                 const int startAngle_,
                                 const int endAngle_, const int segments_, const TColor color_) {
-        ::DrawRingLines(center_.ToRaylibVec(),
-                        innerRadius_,
-                        outerRadius_,
-                        startAngle_,
-                        endAngle_,
-                        segments_,
-                        color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RING_LINES);
+        command.Points[0] = center_;
+        command.Values[0] = innerRadius_;
+        command.Values[1] = outerRadius_;
+        command.Integers[0] = startAngle_;
+        command.Integers[1] = endAngle_;
+        command.Integers[2] = segments_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangle(const TVector2 position_, const float width_, const float height_,
@@ -165,10 +214,12 @@ namespace NerdThings::Ngine::Graphics {
 
     void Drawing::DrawRectangle(const TRectangle rectangle_, const TColor color_, const float rotation_,
                                 const TVector2 origin_) {
-        DrawRectanglePro(rectangle_.ToRaylibRect(),
-                         origin_.ToRaylibVec(),
-                         RadToDeg(rotation_),
-                         color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE);
+        command.Rectangles[0] = rectangle_;
+        command.Points[0] = origin_;
+        command.Values[0] = rotation_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleGradientV(const TVector2 position_, const float width_, const float height_,
@@ -196,12 +247,11 @@ namespace NerdThings::Ngine::Graphics {
 
     void Drawing::DrawRectangleGradientV(const TRectangle rectangle_, const TColor color1_,
                                          const TColor color2_) {
-        ::DrawRectangleGradientV(static_cast<int>(rectangle_.X),
-                                 static_cast<int>(rectangle_.Y),
-                                 static_cast<int>(rectangle_.Width),
-                                 static_cast<int>(rectangle_.Height),
-                                 color1_.ToRaylibColor(),
-                                 color2_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_GRADIENT_V);
+        command.Rectangles[0] = rectangle_;
+        command.Colors[0] = color1_;
+        command.Colors[1] = color2_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleGradientH(const TVector2 position_, const float width_, const float height_,
@@ -229,12 +279,11 @@ namespace NerdThings::Ngine::Graphics {
 
     void Drawing::DrawRectangleGradientH(const TRectangle rectangle_, const TColor color1_,
                                          const TColor color2_) {
-        ::DrawRectangleGradientH(static_cast<int>(rectangle_.X),
-                                 static_cast<int>(rectangle_.Y),
-                                 static_cast<int>(rectangle_.Width),
-                                 static_cast<int>(rectangle_.Height),
-                                 color1_.ToRaylibColor(),
-                                 color2_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_GRADIENT_H);
+        command.Rectangles[0] = rectangle_;
+        command.Colors[0] = color1_;
+        command.Colors[1] = color2_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleGradientEx(const TVector2 position_, const float width_, const float height_,
@@ -268,11 +317,13 @@ namespace NerdThings::Ngine::Graphics {
     void Drawing::DrawRectangleGradientEx(const TRectangle rectangle_, const TColor color1_, const TColor color2_,
                                           const TColor color3_,
                                           const TColor color4_) {
-        ::DrawRectangleGradientEx(rectangle_.ToRaylibRect(),
-                                  color1_.ToRaylibColor(),
-                                  color2_.ToRaylibColor(),
-                                  color3_.ToRaylibColor(),
-                                  color4_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_GRADIENT_EX);
+        command.Rectangles[0] = rectangle_;
+        command.Colors[0] = color1_;
+        command.Colors[1] = color2_;
+        command.Colors[2] = color3_;
+        command.Colors[3] = color4_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleLines(const TVector2 position_, const float width_, const float height_,
@@ -298,9 +349,11 @@ namespace NerdThings::Ngine::Graphics {
     }
 
     void Drawing::DrawRectangleLines(const TRectangle rectangle_, const TColor color_, const int lineThickness_) {
-        ::DrawRectangleLinesEx(rectangle_.ToRaylibRect(),
-                               lineThickness_,
-                               color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_LINES);
+        command.Rectangles[0] = rectangle_;
+        command.Integers[0] = lineThickness_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleRounded(const TVector2 position_, const float width_, const float height_,
@@ -331,10 +384,12 @@ namespace NerdThings::Ngine::Graphics {
 
     void Drawing::DrawRectangleRounded(const TRectangle rectangle_, const float roundness_, const int segments_,
                                        const TColor color_) {
-        ::DrawRectangleRounded(rectangle_.ToRaylibRect(),
-                               roundness_,
-                               segments_,
-                               color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_ROUNDED);
+        command.Rectangles[0] = rectangle_;
+        command.Values[0] = roundness_;
+        command.Integers[0] = segments_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawRectangleRoundedLines(const TVector2 position_, const float width_, const float height_,
@@ -369,33 +424,45 @@ namespace NerdThings::Ngine::Graphics {
                                             const int segments_,
                                             const int lineThickness_,
                                             const TColor color_) {
-        ::DrawRectangleRoundedLines(rectangle_.ToRaylibRect(),
-                                    roundness_,
-                                    segments_,
-                                    lineThickness_,
-                                    color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_RECTANGLE_ROUNDED_LINES);
+        command.Rectangles[0] = rectangle_;
+        command.Values[0] = roundness_;
+        command.Integers[0] = segments_;
+        command.Integers[1] = lineThickness_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawText(std::shared_ptr<TFont> font_, const std::string &string_, const TVector2 position_,
                            const float fontSize_,
                            const float spacing_, const TColor color_) {
-        DrawTextEx(font_->ToRaylibFont(),
-                   string_.c_str(),
-                   position_.ToRaylibVec(),
-                   fontSize_,
-                   spacing_,
-                   color_.ToRaylibColor());
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_TEXT);
+        command.TextureID = GetFontTextureID(font_);
+        command.Resources[0] = buffer.AddResource(font_);
+        command.Offset = buffer.AddText(string_);
+        command.Count = static_cast<unsigned int>(string_.size());
+        command.Points[0] = position_;
+        command.Values[0] = fontSize_;
+        command.Values[1] = spacing_;
+        command.Colors[0] = color_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawTextRect(std::shared_ptr<TFont> font_, const std::string &string_, const TRectangle rectangle_,
                                const float fontSize_, const float spacing_, const TColor color_, const bool wordWrap_) {
-        DrawTextRec(font_->ToRaylibFont(),
-                    string_.c_str(),
-                    rectangle_.ToRaylibRect(),
-                    fontSize_,
-                    spacing_,
-                    wordWrap_,
-                    color_.ToRaylibColor());
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_TEXT_RECT);
+        command.TextureID = GetFontTextureID(font_);
+        command.Resources[0] = buffer.AddResource(font_);
+        command.Offset = buffer.AddText(string_);
+        command.Count = static_cast<unsigned int>(string_.size());
+        command.Rectangles[0] = rectangle_;
+        command.Values[0] = fontSize_;
+        command.Values[1] = spacing_;
+        command.Integers[0] = wordWrap_;
+        command.Colors[0] = color_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawTextRectEx(std::shared_ptr<TFont> font_, const std::string &string_, const TRectangle rectangle_,
@@ -403,17 +470,22 @@ namespace NerdThings::Ngine::Graphics {
                                  const int selectStart_,
                                  const int selectLength_, const TColor selectText_, const TColor selectBack_,
                                  const bool wordWrap_) {
-        DrawTextRecEx(font_->ToRaylibFont(),
-                      string_.c_str(),
-                      rectangle_.ToRaylibRect(),
-                      fontSize_,
-                      spacing_,
-                      wordWrap_,
-                      color_.ToRaylibColor(),
-                      selectStart_,
-                      selectLength_,
-                      selectText_.ToRaylibColor(),
-                      selectBack_.ToRaylibColor());
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_TEXT_RECT_EX);
+        command.TextureID = GetFontTextureID(font_);
+        command.Resources[0] = buffer.AddResource(font_);
+        command.Offset = buffer.AddText(string_);
+        command.Count = static_cast<unsigned int>(string_.size());
+        command.Rectangles[0] = rectangle_;
+        command.Values[0] = fontSize_;
+        command.Values[1] = spacing_;
+        command.Integers[0] = wordWrap_;
+        command.Integers[1] = selectStart_;
+        command.Integers[2] = selectLength_;
+        command.Colors[0] = color_;
+        command.Colors[1] = selectText_;
+        command.Colors[2] = selectBack_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawTexture(std::shared_ptr<TTexture2D> texture_, const TVector2 position_, const TColor color_,
@@ -497,56 +569,94 @@ namespace NerdThings::Ngine::Graphics {
                               const float rotation_) {
         if (texture_ == nullptr) return;
 
-        DrawTexturePro(texture_->ToRaylibTex(),
-                       sourceRectangle_.ToRaylibRect(),
-                       destRectangle_.ToRaylibRect(),
-                       origin_.ToRaylibVec(),
-                       RadToDeg(rotation_),
-                       color_.ToRaylibColor());
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_TEXTURE);
+        command.TextureID = texture_->ID;
+        command.Resources[0] = buffer.AddResource(texture_);
+        command.Rectangles[0] = destRectangle_;
+        command.Rectangles[1] = sourceRectangle_;
+        command.Points[0] = origin_;
+        command.Values[0] = rotation_;
+        command.Colors[0] = color_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawTriangle(const TVector2 v1_, const TVector2 v2_, const TVector2 v3_,
                                const TColor color_) {
-        ::DrawTriangle(v1_.ToRaylibVec(),
-                       v2_.ToRaylibVec(),
-                       v3_.ToRaylibVec(),
-                       color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_TRIANGLE);
+        command.Points[0] = v1_;
+        command.Points[1] = v2_;
+        command.Points[2] = v3_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawTriangleLines(const TVector2 v1_, const TVector2 v2_, const TVector2 v3_,
                                     const TColor color_) {
-        ::DrawTriangleLines(v1_.ToRaylibVec(),
-                            v2_.ToRaylibVec(),
-                            v3_.ToRaylibVec(),
-                            color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_TRIANGLE_LINES);
+        command.Points[0] = v1_;
+        command.Points[1] = v2_;
+        command.Points[2] = v3_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::DrawTriangleFan(std::vector<TVector2> points_, const TColor color_) {
-        //Build points array
-        auto pts = new Vector2[points_.size()];
-        for (unsigned int i = 0; i < points_.size(); i++) {
-            pts[i] = points_[i].ToRaylibVec();
-        }
-
-        //Draw
-        ::DrawTriangleFan(pts,
-                          points_.size(),
-                          color_.ToRaylibColor());
-
-        //Delete points array
-        delete[] pts;
+        auto &buffer = GetCommandBuffer();
+        TRenderCommand command(COMMAND_TRIANGLE_FAN);
+        command.Offset = buffer.AddVertices(points_);
+        command.Count = static_cast<unsigned int>(points_.size());
+        command.Colors[0] = color_;
+        AddCommand(buffer, command);
     }
 
     void Drawing::DrawPoly(const TVector2 center_, const int sides_, const float radius_, const float rotation_,
                            const TColor color_) {
-        ::DrawPoly(center_.ToRaylibVec(),
-                   sides_,
-                   radius_,
-                   RadToDeg(rotation_),
-                   color_.ToRaylibColor());
+        TRenderCommand command(COMMAND_POLY);
+        command.Points[0] = center_;
+        command.Integers[0] = sides_;
+        command.Values[0] = radius_;
+        command.Values[1] = rotation_;
+        command.Colors[0] = color_;
+        AddCommand(GetCommandBuffer(), command);
     }
 
     void Drawing::EndDrawing() {
+        _FrameBuffer.EndRecording();
+        _FrameBuffer.Sort();
+        _FrameBuffer.Submit(*_Backend);
+        _Backend->Finish();
+
         ::EndDrawing();
+
+        // Release this frame's resources
+        _FrameBuffer.Clear();
+    }
+
+    RenderCommandBuffer &Drawing::GetCommandBuffer() {
+        auto recording = RenderCommandBuffer::GetRecording();
+        return recording != nullptr ? *recording : ImmediateBuffer;
+    }
+
+    std::shared_ptr<IRenderBackend> Drawing::GetRenderBackend() {
+        return _Backend;
+    }
+
+    void Drawing::SetBatching(bool batching_) {
+        GetCommandBuffer().SetBatching(batching_);
+    }
+
+    void Drawing::SetBlendMode(EBlendMode mode_) {
+        GetCommandBuffer().SetBlendMode(mode_);
+    }
+
+    void Drawing::SetDepth(int depth_) {
+        GetCommandBuffer().SetDepth(depth_);
+    }
+
+    void Drawing::SetRenderBackend(std::shared_ptr<IRenderBackend> backend_) {
+        if (backend_ == nullptr)
+            backend_ = std::make_shared<RaylibRenderBackend>();
+        _Backend = std::move(backend_);
     }
 }
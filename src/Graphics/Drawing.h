@@ -19,19 +19,40 @@
 #include "Color.h"
 #include "Font.h"
 #include "Texture2D.h"
+#include "RenderBackend.h"
+#include "RenderCommandBuffer.h"
 
 namespace NerdThings::Ngine::Graphics {
     /*
-     * Connect to the raylib renderer directly
+     * Draw through the render backend.
+     * Between BeginDrawing and EndDrawing calls are recorded, then sorted and submitted at EndDrawing.
+     * Outside of a frame they run straight away.
      */
     class NEAPI Drawing {
-    public:
-        // TODO: Depth support through batching?
+        // Private Fields
 
+        /*
+         * The backend commands are submitted to
+         */
+        static std::shared_ptr<IRenderBackend> _Backend;
+
+        /*
+         * The commands for this frame
+         */
+        static RenderCommandBuffer _FrameBuffer;
+
+    public:
         // Public Methods
 
         /*
-         * Begin a drawing loop
+         * Add a command to a buffer from GetCommandBuffer.
+         * Outside of a frame it is run straight away.
+         */
+        static void AddCommand(RenderCommandBuffer &buffer_, const TRenderCommand &command_);
+
+        /*
+         * Begin a drawing loop.
+         * Drawing calls on this thread are recorded until EndDrawing.
          */
         static void BeginDrawing();
 
@@ -40,6 +61,12 @@ namespace NerdThings::Ngine::Graphics {
          */
         static void Clear(TColor color_);
 
+        /*
+         * Draw the commands in another buffer.
+         * The buffer should be sorted, and must not change until this frame is submitted.
+         */
+        static void DrawCommandBuffer(const RenderCommandBuffer &buffer_);
+
         /*
          * Draw a pixel
          */
@@ -313,10 +340,46 @@ namespace NerdThings::Ngine::Graphics {
          */
         static void DrawPoly(TVector2 center_, int sides_, float radius_, float rotation_,
                              TColor color_);
+
         /*
          * End a drawing loop.
+         * Recorded commands are sorted and submitted to the render backend.
          */
         static void EndDrawing();
+
+        /*
+         * Get the buffer drawing calls on this thread go to.
+         * This is the buffer being recorded, or outside of a frame one that runs commands as they are added.
+         */
+        static RenderCommandBuffer &GetCommandBuffer();
+
+        /*
+         * Get the render backend
+         */
+        static std::shared_ptr<IRenderBackend> GetRenderBackend();
+
+        /*
+         * Set whether or not draws at the same depth are grouped by blend mode and texture this frame.
+         * This changes the order of overlapping draws at the same depth.
+         */
+        static void SetBatching(bool batching_);
+
+        /*
+         * Set the blend mode of following draws this frame
+         */
+        static void SetBlendMode(EBlendMode mode_);
+
+        /*
+         * Set the depth of following draws this frame.
+         * Higher depths are drawn on top of lower ones, until the render target or camera changes.
+         */
+        static void SetDepth(int depth_);
+
+        /*
+         * Set the render backend.
+         * Pass null to go back to raylib. Must not be changed during a frame.
+         */
+        static void SetRenderBackend(std::shared_ptr<IRenderBackend> backend_);
     };
 }
 
@@ -11,14 +11,39 @@
 
 #include "GraphicsManager.h"
 
+#include <future>
+
+#include "Drawing.h"
+
 namespace NerdThings::Ngine::Graphics {
+    /*
+     * The targets pushed by the command buffer being recorded on this thread.
+     * Recorded pushes and pops apply to the real stack when the buffer is submitted.
+     */
+    static thread_local std::vector<std::shared_ptr<TRenderTarget>> RecordingTargetStack;
+
     // Private Fields
 
+    std::atomic<Threading::JobSystem *> GraphicsManager::_JobSystem(nullptr);
+
     std::vector<std::shared_ptr<TRenderTarget>> GraphicsManager::_RenderTargetStack;
 
     // Public Methods
 
     std::shared_ptr<TRenderTarget> GraphicsManager::PopTarget(bool &popped_) {
+        auto recording = RenderCommandBuffer::GetRecording();
+        if (recording != nullptr) {
+            popped_ = !RecordingTargetStack.empty();
+            if (!popped_)
+                return nullptr;
+
+            auto pop = RecordingTargetStack.back();
+            RecordingTargetStack.pop_back();
+
+            Drawing::AddCommand(*recording, TRenderCommand(COMMAND_POP_TARGET));
+            return pop;
+        }
+
         if (!_RenderTargetStack.empty()) {
             // Get target
             auto pop = _RenderTargetStack.back();
@@ -43,6 +68,16 @@ namespace NerdThings::Ngine::Graphics {
     }
 
     void GraphicsManager::PushTarget(std::shared_ptr<TRenderTarget> target_) {
+        auto recording = RenderCommandBuffer::GetRecording();
+        if (recording != nullptr) {
+            RecordingTargetStack.push_back(target_);
+
+            TRenderCommand command(COMMAND_PUSH_TARGET);
+            command.Resources[0] = recording->AddResource(target_);
+            Drawing::AddCommand(*recording, command);
+            return;
+        }
+
         // Stop using current target
         if (!_RenderTargetStack.empty())
             EndTextureMode();
@@ -54,7 +89,29 @@ namespace NerdThings::Ngine::Graphics {
         BeginTextureMode(target_->ToRaylibTarget());
     }
 
+    void GraphicsManager::ReleaseOnMainThread(std::shared_ptr<void> resource_) {
+        auto jobSystem = _JobSystem.load();
+        if (resource_ == nullptr || jobSystem == nullptr || jobSystem->IsMainThread())
+            return;
+
+        // The job holds the last reference, unless someone else still has one
+        jobSystem->RunOnMainThread([resource = std::move(resource_)]() mutable {
+            resource = nullptr;
+        });
+    }
+
     void GraphicsManager::ReplaceTarget(std::shared_ptr<TRenderTarget> old_, std::shared_ptr<TRenderTarget> new_) {
+        auto recording = RenderCommandBuffer::GetRecording();
+        if (recording != nullptr) {
+            std::replace(RecordingTargetStack.begin(), RecordingTargetStack.end(), old_, new_);
+
+            TRenderCommand command(COMMAND_REPLACE_TARGET);
+            command.Resources[0] = recording->AddResource(old_);
+            command.Resources[1] = recording->AddResource(new_);
+            Drawing::AddCommand(*recording, command);
+            return;
+        }
+
         const auto oldPos = std::find(_RenderTargetStack.begin(), _RenderTargetStack.end(), old_) - _RenderTargetStack.
             begin();
 
@@ -67,4 +124,27 @@ namespace NerdThings::Ngine::Graphics {
         // Send to stack
         _RenderTargetStack[oldPos] = new_;
     }
+
+    void GraphicsManager::RunOnMainThread(const std::function<void()> &func_) {
+        auto jobSystem = _JobSystem.load();
+        if (jobSystem == nullptr || jobSystem->IsMainThread()) {
+            func_();
+            return;
+        }
+
+        std::promise<void> done;
+        jobSystem->RunOnMainThread([&]() {
+            try {
+                func_();
+                done.set_value();
+            } catch (...) {
+                done.set_exception(std::current_exception());
+            }
+        });
+        done.get_future().get();
+    }
+
+    void GraphicsManager::SetJobSystem(Threading::JobSystem *jobSystem_) {
+        _JobSystem = jobSystem_;
+    }
 }
@@ -14,15 +14,25 @@
 
 #include "../ngine.h"
 
+#include <atomic>
+#include <functional>
+
+#include "../Threading/JobSystem.h"
 #include "RenderTarget.h"
 
 namespace NerdThings::Ngine::Graphics {
     /*
-     * Graphics management class
+     * Graphics management class.
+     * Target changes made while recording a command buffer are recorded with it.
      */
     class NEAPI GraphicsManager {
         // Private fields
 
+        /*
+         * The job system used to reach the main thread, while graphics calls are made off it
+         */
+        static std::atomic<Threading::JobSystem *> _JobSystem;
+
         /*
          * The render target stack
          */
@@ -41,10 +51,28 @@ namespace NerdThings::Ngine::Graphics {
          */
         static void PushTarget(std::shared_ptr<TRenderTarget> target_);
 
+        /*
+         * Release a graphics resource on the main thread.
+         * Use for resources that may be freed on another thread, as GL resources must be freed with the context.
+         */
+        static void ReleaseOnMainThread(std::shared_ptr<void> resource_);
+
         /*
          * Replace a target on the stack
          */
         static void ReplaceTarget(std::shared_ptr<TRenderTarget> old_, std::shared_ptr<TRenderTarget> new_);
+
+        /*
+         * Run a function on the main thread and wait for it.
+         * Use to create graphics resources from another thread. Runs straight away on the main thread.
+         */
+        static void RunOnMainThread(const std::function<void()> &func_);
+
+        /*
+         * Set the job system used to reach the main thread.
+         * Set by the game while updates and draws run off the main thread, null otherwise.
+         */
+        static void SetJobSystem(Threading::JobSystem *jobSystem_);
     };
 }
 
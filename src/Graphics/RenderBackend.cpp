@@ -0,0 +1,333 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "RenderBackend.h"
+
+#include <rlgl.h>
+
+#include "Font.h"
+#include "GraphicsManager.h"
+#include "Texture2D.h"
+
+namespace NerdThings::Ngine::Graphics {
+    /*
+     * Build a raylib point array from buffer vertices
+     */
+    static std::vector<Vector2> ToRaylibPoints(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) {
+        std::vector<Vector2> points(command_.Count);
+        auto vertices = buffer_.GetVertices(command_.Offset);
+        for (unsigned int i = 0; i < command_.Count; i++) {
+            points[i] = vertices[i].ToRaylibVec();
+        }
+        return points;
+    }
+
+    // RaylibRenderBackend Public Methods
+
+    void RaylibRenderBackend::Execute(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) {
+        if (command_.Blend != _BlendMode) {
+            BeginBlendMode(command_.Blend);
+            _BlendMode = command_.Blend;
+        }
+
+        const auto &points = command_.Points;
+        const auto &rectangles = command_.Rectangles;
+        const auto &values = command_.Values;
+        const auto &integers = command_.Integers;
+        const auto color = command_.Colors[0].ToRaylibColor();
+
+        switch (command_.Type) {
+            case COMMAND_CIRCLE:
+                DrawCircleV(points[0].ToRaylibVec(),
+                            values[0],
+                            color);
+                break;
+            case COMMAND_CIRCLE_GRADIENT:
+                DrawCircleGradient(static_cast<int>(points[0].X),
+                                   static_cast<int>(points[0].Y),
+                                   values[0],
+                                   color,
+                                   command_.Colors[1].ToRaylibColor());
+                break;
+            case COMMAND_CIRCLE_LINES:
+                DrawCircleLines(static_cast<int>(points[0].X),
+                                static_cast<int>(points[0].Y),
+                                values[0],
+                                color);
+                break;
+            case COMMAND_CIRCLE_SECTOR:
+                DrawCircleSector(points[0].ToRaylibVec(),
+                                 values[0],
+                                 integers[0],
+                                 integers[1],
+                                 integers[2],
+                                 color);
+                break;
+            case COMMAND_CIRCLE_SECTOR_LINES:
+                DrawCircleSectorLines(points[0].ToRaylibVec(),
+                                      values[0],
+                                      integers[0],
+                                      integers[1],
+                                      integers[2],
+                                      color);
+                break;
+            case COMMAND_FPS:
+                DrawFPS(static_cast<int>(points[0].X),
+                        static_cast<int>(points[0].Y));
+                break;
+            case COMMAND_LINE:
+                DrawLineEx(points[0].ToRaylibVec(),
+                           points[1].ToRaylibVec(),
+                           values[0],
+                           color);
+                break;
+            case COMMAND_LINE_BEZIER:
+                DrawLineBezier(points[0].ToRaylibVec(),
+                               points[1].ToRaylibVec(),
+                               values[0],
+                               color);
+                break;
+            case COMMAND_LINE_STRIP: {
+                auto pts = ToRaylibPoints(command_, buffer_);
+                DrawLineStrip(pts.data(),
+                              pts.size(),
+                              color);
+                break;
+            }
+            case COMMAND_PIXEL:
+                DrawPixelV(points[0].ToRaylibVec(),
+                           color);
+                break;
+            case COMMAND_POLY:
+                DrawPoly(points[0].ToRaylibVec(),
+                         integers[0],
+                         values[0],
+                         RadToDeg(values[1]),
+                         color);
+                break;
+            case COMMAND_RECTANGLE:
+                DrawRectanglePro(rectangles[0].ToRaylibRect(),
+                                 points[0].ToRaylibVec(),
+                                 RadToDeg(values[0]),
+                                 color);
+                break;
+            case COMMAND_RECTANGLE_GRADIENT_EX:
+                DrawRectangleGradientEx(rectangles[0].ToRaylibRect(),
+                                        color,
+                                        command_.Colors[1].ToRaylibColor(),
+                                        command_.Colors[2].ToRaylibColor(),
+                                        command_.Colors[3].ToRaylibColor());
+                break;
+            case COMMAND_RECTANGLE_GRADIENT_H:
+                DrawRectangleGradientH(static_cast<int>(rectangles[0].X),
+                                       static_cast<int>(rectangles[0].Y),
+                                       static_cast<int>(rectangles[0].Width),
+                                       static_cast<int>(rectangles[0].Height),
+                                       color,
+                                       command_.Colors[1].ToRaylibColor());
+                break;
+            case COMMAND_RECTANGLE_GRADIENT_V:
+                DrawRectangleGradientV(static_cast<int>(rectangles[0].X),
+                                       static_cast<int>(rectangles[0].Y),
+                                       static_cast<int>(rectangles[0].Width),
+                                       static_cast<int>(rectangles[0].Height),
+                                       color,
+                                       command_.Colors[1].ToRaylibColor());
+                break;
+            case COMMAND_RECTANGLE_LINES:
+                DrawRectangleLinesEx(rectangles[0].ToRaylibRect(),
+                                     integers[0],
+                                     color);
+                break;
+            case COMMAND_RECTANGLE_ROUNDED:
+                DrawRectangleRounded(rectangles[0].ToRaylibRect(),
+                                     values[0],
+                                     integers[0],
+                                     color);
+                break;
+            case COMMAND_RECTANGLE_ROUNDED_LINES:
+                DrawRectangleRoundedLines(rectangles[0].ToRaylibRect(),
+                                          values[0],
+                                          integers[0],
+                                          integers[1],
+                                          color);
+                break;
+            case COMMAND_RING:
+                DrawRing(points[0].ToRaylibVec(),
+                         values[0],
+                         values[1],
+                         integers[0],
+                         integers[1],
+                         integers[2],
+                         color);
+                break;
+            case COMMAND_RING_LINES:
+                DrawRingLines(points[0].ToRaylibVec(),
+                              values[0],
+                              values[1],
+                              integers[0],
+                              integers[1],
+                              integers[2],
+                              color);
+                break;
+            case COMMAND_TEXT:
+                DrawTextEx(buffer_.GetResource<TFont>(command_.Resources[0])->ToRaylibFont(),
+                           buffer_.GetText(command_.Offset),
+                           points[0].ToRaylibVec(),
+                           values[0],
+                           values[1],
+                           color);
+                break;
+            case COMMAND_TEXT_RECT:
+                DrawTextRec(buffer_.GetResource<TFont>(command_.Resources[0])->ToRaylibFont(),
+                            buffer_.GetText(command_.Offset),
+                            rectangles[0].ToRaylibRect(),
+                            values[0],
+                            values[1],
+                            integers[0] != 0,
+                            color);
+                break;
+            case COMMAND_TEXT_RECT_EX:
+                DrawTextRecEx(buffer_.GetResource<TFont>(command_.Resources[0])->ToRaylibFont(),
+                              buffer_.GetText(command_.Offset),
+                              rectangles[0].ToRaylibRect(),
+                              values[0],
+                              values[1],
+                              integers[0] != 0,
+                              color,
+                              integers[1],
+                              integers[2],
+                              command_.Colors[1].ToRaylibColor(),
+                              command_.Colors[2].ToRaylibColor());
+                break;
+            case COMMAND_TEXTURE:
+                DrawTexturePro(buffer_.GetResource<TTexture2D>(command_.Resources[0])->ToRaylibTex(),
+                               rectangles[1].ToRaylibRect(),
+                               rectangles[0].ToRaylibRect(),
+                               points[0].ToRaylibVec(),
+                               RadToDeg(values[0]),
+                               color);
+                break;
+            case COMMAND_TRIANGLE:
+                DrawTriangle(points[0].ToRaylibVec(),
+                             points[1].ToRaylibVec(),
+                             points[2].ToRaylibVec(),
+                             color);
+                break;
+            case COMMAND_TRIANGLE_FAN: {
+                auto pts = ToRaylibPoints(command_, buffer_);
+                DrawTriangleFan(pts.data(),
+                                pts.size(),
+                                color);
+                break;
+            }
+            case COMMAND_TRIANGLE_LINES:
+                DrawTriangleLines(points[0].ToRaylibVec(),
+                                  points[1].ToRaylibVec(),
+                                  points[2].ToRaylibVec(),
+                                  color);
+                break;
+            case COMMAND_BEGIN_CAMERA: {
+                // This works how we want, raylib's doesn't work as well
+                auto mat = buffer_.GetMatrix(command_.Offset);
+                EndMode2D(); //Ironic, isn't it.
+                rlMultMatrixf(MatrixToFloat(*reinterpret_cast<Matrix*>(&mat))); //Hacky, but sure
+                break;
+            }
+            case COMMAND_CLEAR:
+                ClearBackground(color);
+                break;
+            case COMMAND_END_CAMERA:
+                EndMode2D();
+                break;
+            case COMMAND_POP_TARGET: {
+                bool popped;
+                GraphicsManager::PopTarget(popped);
+                break;
+            }
+            case COMMAND_PUSH_TARGET:
+                GraphicsManager::PushTarget(buffer_.GetResource<TRenderTarget>(command_.Resources[0]));
+                break;
+            case COMMAND_REPLACE_TARGET:
+                GraphicsManager::ReplaceTarget(buffer_.GetResource<TRenderTarget>(command_.Resources[0]),
+                                               buffer_.GetResource<TRenderTarget>(command_.Resources[1]));
+                break;
+            default:
+                break;
+        }
+    }
+
+    void RaylibRenderBackend::Finish() {
+        if (_BlendMode != BLEND_ALPHA) {
+            EndBlendMode();
+            _BlendMode = BLEND_ALPHA;
+        }
+    }
+
+    // RecordingRenderBackend Public Constructor(s)
+
+    RecordingRenderBackend::RecordingRenderBackend(bool keepCommands_)
+        : _KeepCommands(keepCommands_) {}
+
+    // RecordingRenderBackend Public Methods
+
+    void RecordingRenderBackend::Clear() {
+        _BlendChanges = 0;
+        _Commands.clear();
+        _CommandCount = 0;
+        _Frames = 0;
+        _LastBlendMode = BLEND_ALPHA;
+        _LastTexture = 0;
+        _TextureChanges = 0;
+    }
+
+    void RecordingRenderBackend::Execute(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) {
+        _CommandCount++;
+
+        if (command_.Blend != _LastBlendMode) {
+            _BlendChanges++;
+            _LastBlendMode = command_.Blend;
+        }
+
+        if (command_.TextureID != 0 && command_.TextureID != _LastTexture) {
+            _TextureChanges++;
+            _LastTexture = command_.TextureID;
+        }
+
+        if (_KeepCommands)
+            _Commands.push_back(command_);
+    }
+
+    void RecordingRenderBackend::Finish() {
+        _Frames++;
+        _LastBlendMode = BLEND_ALPHA;
+    }
+
+    unsigned int RecordingRenderBackend::GetBlendChanges() const {
+        return _BlendChanges;
+    }
+
+    size_t RecordingRenderBackend::GetCommandCount() const {
+        return _CommandCount;
+    }
+
+    const std::vector<TRenderCommand> &RecordingRenderBackend::GetCommands() const {
+        return _Commands;
+    }
+
+    unsigned int RecordingRenderBackend::GetFrameCount() const {
+        return _Frames;
+    }
+
+    unsigned int RecordingRenderBackend::GetTextureChanges() const {
+        return _TextureChanges;
+    }
+}
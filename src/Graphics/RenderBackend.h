@@ -0,0 +1,157 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include "../ngine.h"
+
+#include "RenderCommandBuffer.h"
+
+namespace NerdThings::Ngine::Graphics {
+    /*
+     * Runs render commands
+     */
+    class NEAPI IRenderBackend {
+    public:
+        // Destructor
+
+        virtual ~IRenderBackend() = default;
+
+        // Public Methods
+
+        /*
+         * Run a command recorded in buffer_
+         */
+        virtual void Execute(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) = 0;
+
+        /*
+         * Called once all of a frame's commands have run
+         */
+        virtual void Finish() {}
+    };
+
+    /*
+     * Runs render commands with raylib.
+     * Must be used from the thread owning the graphics context.
+     */
+    class NEAPI RaylibRenderBackend : public IRenderBackend {
+        // Private Fields
+
+        /*
+         * The blend mode in use
+         */
+        EBlendMode _BlendMode = BLEND_ALPHA;
+
+    public:
+        // Public Methods
+
+        void Execute(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) override;
+
+        void Finish() override;
+    };
+
+    /*
+     * Keeps render commands instead of running them.
+     * Used to test and benchmark rendering without a graphics context.
+     */
+    class NEAPI RecordingRenderBackend : public IRenderBackend {
+        // Private Fields
+
+        /*
+         * Blend mode changes
+         */
+        unsigned int _BlendChanges = 0;
+
+        /*
+         * Executed commands
+         */
+        std::vector<TRenderCommand> _Commands;
+
+        /*
+         * Number of commands executed
+         */
+        size_t _CommandCount = 0;
+
+        /*
+         * Finished frames
+         */
+        unsigned int _Frames = 0;
+
+        /*
+         * Whether or not executed commands are kept
+         */
+        bool _KeepCommands;
+
+        /*
+         * The last blend mode used
+         */
+        EBlendMode _LastBlendMode = BLEND_ALPHA;
+
+        /*
+         * The last texture used
+         */
+        unsigned int _LastTexture = 0;
+
+        /*
+         * Texture changes
+         */
+        unsigned int _TextureChanges = 0;
+
+    public:
+        // Public Constructor(s)
+
+        /*
+         * Create a recording backend.
+         * If commands are not kept, only counts are recorded.
+         */
+        explicit RecordingRenderBackend(bool keepCommands_ = true);
+
+        // Public Methods
+
+        /*
+         * Forget everything recorded
+         */
+        void Clear();
+
+        void Execute(const TRenderCommand &command_, const RenderCommandBuffer &buffer_) override;
+
+        void Finish() override;
+
+        /*
+         * Get the number of times the blend mode changed between commands
+         */
+        [[nodiscard]] unsigned int GetBlendChanges() const;
+
+        /*
+         * Get the number of commands executed
+         */
+        [[nodiscard]] size_t GetCommandCount() const;
+
+        /*
+         * Get the executed commands, in execution order.
+         * Empty unless commands are kept.
+         */
+        [[nodiscard]] const std::vector<TRenderCommand> &GetCommands() const;
+
+        /*
+         * Get the number of finished frames
+         */
+        [[nodiscard]] unsigned int GetFrameCount() const;
+
+        /*
+         * Get the number of times the texture changed between textured commands
+         */
+        [[nodiscard]] unsigned int GetTextureChanges() const;
+    };
+}
+
+#endif //RENDERBACKEND_H
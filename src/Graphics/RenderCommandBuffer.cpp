@@ -0,0 +1,220 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "RenderCommandBuffer.h"
+
+#include <array>
+
+#include "RenderBackend.h"
+
+namespace NerdThings::Ngine::Graphics {
+    /*
+     * The buffer being recorded on this thread.
+     * Kept out of the class, as thread local data cannot be exported from a DLL.
+     */
+    static thread_local RenderCommandBuffer *Recording = nullptr;
+
+    /*
+     * Sort key layout, from most to least significant:
+     * pass (24 bits), depth (16 bits), blend mode (2 bits), texture (22 bits)
+     */
+    static const std::uint64_t PassShift = 40;
+    static const std::uint64_t MaxPass = (1ULL << 24) - 1;
+    static const std::uint64_t DepthShift = 24;
+    static const std::uint64_t BlendShift = 22;
+    static const std::uint64_t TextureMask = (1ULL << 22) - 1;
+
+    /*
+     * The key bits only used when batching
+     */
+    static const std::uint64_t BatchMask = (1ULL << DepthShift) - 1;
+
+    // Public Methods
+
+    void RenderCommandBuffer::Add(TRenderCommand command_) {
+        command_.Blend = _BlendMode;
+
+        if (command_.Type >= COMMAND_BEGIN_CAMERA) {
+            // Barriers start a new pass and go before everything in it.
+            // Past the last pass barriers share one, which only matters when using depth.
+            if (_Pass < MaxPass)
+                _Pass++;
+
+            command_.Key = _Pass << PassShift;
+        } else {
+            command_.Key = (_Pass << PassShift)
+                           | (static_cast<std::uint64_t>(_Depth + 32768) << DepthShift)
+                           | (static_cast<std::uint64_t>(_BlendMode) << BlendShift)
+                           | (command_.TextureID & TextureMask);
+        }
+
+        _Commands.push_back(command_);
+        _Sorted = false;
+    }
+
+    unsigned int RenderCommandBuffer::AddMatrix(const TMatrix &matrix_) {
+        _Matrices.push_back(matrix_);
+        return static_cast<unsigned int>(_Matrices.size() - 1);
+    }
+
+    unsigned int RenderCommandBuffer::AddResource(std::shared_ptr<void> resource_) {
+        // The same resource is often used many times in a row
+        if (_Resources.empty() || _Resources.back() != resource_)
+            _Resources.push_back(std::move(resource_));
+        return static_cast<unsigned int>(_Resources.size() - 1);
+    }
+
+    unsigned int RenderCommandBuffer::AddText(const std::string &text_) {
+        auto offset = static_cast<unsigned int>(_Text.size());
+        _Text.insert(_Text.end(), text_.begin(), text_.end());
+        _Text.push_back('\0');
+        return offset;
+    }
+
+    unsigned int RenderCommandBuffer::AddVertices(const std::vector<TVector2> &vertices_) {
+        auto offset = static_cast<unsigned int>(_Vertices.size());
+        _Vertices.insert(_Vertices.end(), vertices_.begin(), vertices_.end());
+        return offset;
+    }
+
+    void RenderCommandBuffer::BeginRecording() {
+        if (Recording != nullptr) {
+            ConsoleMessage("Attempted to record two command buffers at once on one thread.", "FATAL", "RENDER COMMAND BUFFER");
+            throw std::runtime_error("This thread is already recording a command buffer.");
+        }
+
+        Clear();
+        _Batching = false;
+        _BlendMode = BLEND_ALPHA;
+        _Depth = 0;
+        Recording = this;
+    }
+
+    void RenderCommandBuffer::Clear() {
+        _Commands.clear();
+        _Matrices.clear();
+        _Order.clear();
+        _Pass = 0;
+        _Resources.clear();
+        _Sorted = false;
+        _Text.clear();
+        _Vertices.clear();
+    }
+
+    void RenderCommandBuffer::EndRecording() {
+        if (Recording == this)
+            Recording = nullptr;
+    }
+
+    bool RenderCommandBuffer::GetBatching() const {
+        return _Batching;
+    }
+
+    const TRenderCommand &RenderCommandBuffer::GetCommand(unsigned int index_) const {
+        return _Commands[index_];
+    }
+
+    size_t RenderCommandBuffer::GetCommandCount() const {
+        return _Commands.size();
+    }
+
+    int RenderCommandBuffer::GetDepth() const {
+        return _Depth;
+    }
+
+    const TMatrix &RenderCommandBuffer::GetMatrix(unsigned int index_) const {
+        return _Matrices[index_];
+    }
+
+    RenderCommandBuffer *RenderCommandBuffer::GetRecording() {
+        return Recording;
+    }
+
+    const char *RenderCommandBuffer::GetText(unsigned int offset_) const {
+        return &_Text[offset_];
+    }
+
+    const TVector2 *RenderCommandBuffer::GetVertices(unsigned int offset_) const {
+        return _Vertices.data() + offset_;
+    }
+
+    void RenderCommandBuffer::SetBatching(bool batching_) {
+        _Batching = batching_;
+    }
+
+    void RenderCommandBuffer::SetBlendMode(EBlendMode mode_) {
+        _BlendMode = mode_;
+    }
+
+    void RenderCommandBuffer::SetDepth(int depth_) {
+        _Depth = std::max(-32768, std::min(depth_, 32767));
+    }
+
+    void RenderCommandBuffer::Sort() {
+        const auto count = _Commands.size();
+        const auto mask = _Batching ? ~0ULL : ~BatchMask;
+
+        _Order.resize(count);
+        _SortKeys.resize(count);
+        _SortKeysScratch.resize(count);
+        _SortOrderScratch.resize(count);
+
+        // Count every byte of the keys in one go
+        std::array<std::array<size_t, 256>, 8> counts{};
+        for (size_t i = 0; i < count; i++) {
+            _Order[i] = static_cast<std::uint32_t>(i);
+            _SortKeys[i] = _Commands[i].Key & mask;
+
+            for (auto digit = 0; digit < 8; digit++) {
+                counts[digit][(_SortKeys[i] >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        // Least significant byte first, each pass keeps the order of the last
+        for (auto digit = 0; digit < 8 && count > 0; digit++) {
+            const auto shift = digit * 8;
+            auto &digitCounts = counts[digit];
+
+            // Every key has the same byte here, so nothing would move
+            if (digitCounts[(_SortKeys[0] >> shift) & 0xFF] == count)
+                continue;
+
+            size_t offset = 0;
+            for (auto &digitCount : digitCounts) {
+                auto c = digitCount;
+                digitCount = offset;
+                offset += c;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                auto destination = digitCounts[(_SortKeys[i] >> shift) & 0xFF]++;
+                _SortKeysScratch[destination] = _SortKeys[i];
+                _SortOrderScratch[destination] = _Order[i];
+            }
+
+            _SortKeys.swap(_SortKeysScratch);
+            _Order.swap(_SortOrderScratch);
+        }
+
+        _Sorted = true;
+    }
+
+    void RenderCommandBuffer::Submit(IRenderBackend &backend_) const {
+        for (size_t i = 0; i < _Commands.size(); i++) {
+            const auto &command = _Commands[_Sorted ? _Order[i] : i];
+
+            if (command.Type == COMMAND_EXECUTE_BUFFER)
+                GetResource<const RenderCommandBuffer>(command.Resources[0])->Submit(backend_);
+            else
+                backend_.Execute(command, *this);
+        }
+    }
+}
@@ -0,0 +1,349 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef RENDERCOMMANDBUFFER_H
+#define RENDERCOMMANDBUFFER_H
+
+#include "../ngine.h"
+
+#include <cstdint>
+
+#include "Matrix.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+#include "Color.h"
+
+namespace NerdThings::Ngine::Graphics {
+    class IRenderBackend;
+
+    /*
+     * Render command type
+     */
+    enum ERenderCommandType {
+        // Draws
+
+        COMMAND_CIRCLE = 0,
+        COMMAND_CIRCLE_GRADIENT,
+        COMMAND_CIRCLE_LINES,
+        COMMAND_CIRCLE_SECTOR,
+        COMMAND_CIRCLE_SECTOR_LINES,
+        COMMAND_FPS,
+        COMMAND_LINE,
+        COMMAND_LINE_BEZIER,
+        COMMAND_LINE_STRIP,
+        COMMAND_PIXEL,
+        COMMAND_POLY,
+        COMMAND_RECTANGLE,
+        COMMAND_RECTANGLE_GRADIENT_EX,
+        COMMAND_RECTANGLE_GRADIENT_H,
+        COMMAND_RECTANGLE_GRADIENT_V,
+        COMMAND_RECTANGLE_LINES,
+        COMMAND_RECTANGLE_ROUNDED,
+        COMMAND_RECTANGLE_ROUNDED_LINES,
+        COMMAND_RING,
+        COMMAND_RING_LINES,
+        COMMAND_TEXT,
+        COMMAND_TEXT_RECT,
+        COMMAND_TEXT_RECT_EX,
+        COMMAND_TEXTURE,
+        COMMAND_TRIANGLE,
+        COMMAND_TRIANGLE_FAN,
+        COMMAND_TRIANGLE_LINES,
+
+        // Barriers, nothing is sorted across these
+
+        COMMAND_BEGIN_CAMERA,
+        COMMAND_CLEAR,
+        COMMAND_END_CAMERA,
+        COMMAND_EXECUTE_BUFFER,
+        COMMAND_POP_TARGET,
+        COMMAND_PUSH_TARGET,
+        COMMAND_REPLACE_TARGET
+    };
+
+    /*
+     * A recorded render command.
+     * What each field holds depends on the command type, see the Drawing method that records it.
+     */
+    struct NEAPI TRenderCommand {
+        // Public Fields
+
+        /*
+         * Command type
+         */
+        ERenderCommandType Type;
+
+        /*
+         * Sort key, set when recorded
+         */
+        std::uint64_t Key = 0;
+
+        /*
+         * Blend mode, set when recorded
+         */
+        EBlendMode Blend = BLEND_ALPHA;
+
+        /*
+         * The texture sampled, used for batching
+         */
+        unsigned int TextureID = 0;
+
+        /*
+         * Colors
+         */
+        TColor Colors[4];
+
+        /*
+         * Points
+         */
+        TVector2 Points[3];
+
+        /*
+         * Rectangles
+         */
+        TRectangle Rectangles[2];
+
+        /*
+         * Floating point arguments
+         */
+        float Values[3] = {0, 0, 0};
+
+        /*
+         * Integer arguments
+         */
+        int Integers[4] = {0, 0, 0, 0};
+
+        /*
+         * Buffer resource indices
+         */
+        unsigned int Resources[2] = {0, 0};
+
+        /*
+         * Start of this command's vertices, text or matrix in the buffer
+         */
+        unsigned int Offset = 0;
+
+        /*
+         * Number of vertices or characters
+         */
+        unsigned int Count = 0;
+
+        // Public Constructor(s)
+
+        explicit TRenderCommand(ERenderCommandType type_)
+            : Type(type_) {}
+    };
+
+    /*
+     * A per-frame buffer of render commands.
+     * Commands are stored flat alongside the vertices, text and resources they use,
+     * then sorted by key and submitted to a render backend.
+     *
+     * Sort keys order commands by pass, then depth, then (when batching) blend mode and texture.
+     * Every target change, camera change, clear and nested buffer starts a new pass,
+     * so sorting never moves a draw to a different target or camera.
+     */
+    class NEAPI RenderCommandBuffer {
+        // Private Fields
+
+        /*
+         * Whether or not commands are batched by blend mode and texture
+         */
+        bool _Batching = false;
+
+        /*
+         * Blend mode given to new commands
+         */
+        EBlendMode _BlendMode = BLEND_ALPHA;
+
+        /*
+         * Recorded commands, in call order
+         */
+        std::vector<TRenderCommand> _Commands;
+
+        /*
+         * Depth given to new commands
+         */
+        int _Depth = 0;
+
+        /*
+         * Camera matrices
+         */
+        std::vector<TMatrix> _Matrices;
+
+        /*
+         * Command indices in submission order, once sorted
+         */
+        std::vector<std::uint32_t> _Order;
+
+        /*
+         * Current pass
+         */
+        std::uint64_t _Pass = 0;
+
+        /*
+         * Resources used by commands, kept alive until the buffer is cleared
+         */
+        std::vector<std::shared_ptr<void>> _Resources;
+
+        /*
+         * Whether or not _Order is up to date
+         */
+        bool _Sorted = false;
+
+        /*
+         * Radix sort scratch space
+         */
+        std::vector<std::uint64_t> _SortKeys, _SortKeysScratch;
+
+        /*
+         * Radix sort scratch space
+         */
+        std::vector<std::uint32_t> _SortOrderScratch;
+
+        /*
+         * Text, null terminated
+         */
+        std::vector<char> _Text;
+
+        /*
+         * Vertices
+         */
+        std::vector<TVector2> _Vertices;
+
+    public:
+        // Public Methods
+
+        /*
+         * Add a command.
+         * The key and blend mode are filled in from the buffer's state.
+         */
+        void Add(TRenderCommand command_);
+
+        /*
+         * Add a matrix, returning its index
+         */
+        unsigned int AddMatrix(const TMatrix &matrix_);
+
+        /*
+         * Add a resource to keep alive, returning its index
+         */
+        unsigned int AddResource(std::shared_ptr<void> resource_);
+
+        /*
+         * Add text, returning its offset
+         */
+        unsigned int AddText(const std::string &text_);
+
+        /*
+         * Add vertices, returning their offset
+         */
+        unsigned int AddVertices(const std::vector<TVector2> &vertices_);
+
+        /*
+         * Start recording commands from Drawing calls made on this thread.
+         * Anything previously recorded is cleared and the depth, blend mode and batching are reset.
+         */
+        void BeginRecording();
+
+        /*
+         * Clear recorded commands and release their resources.
+         * Capacity is kept for the next frame.
+         */
+        void Clear();
+
+        /*
+         * Stop recording on this thread
+         */
+        void EndRecording();
+
+        /*
+         * Get whether or not commands are batched when sorted
+         */
+        [[nodiscard]] bool GetBatching() const;
+
+        /*
+         * Get a command
+         */
+        [[nodiscard]] const TRenderCommand &GetCommand(unsigned int index_) const;
+
+        /*
+         * Get the number of recorded commands
+         */
+        [[nodiscard]] size_t GetCommandCount() const;
+
+        /*
+         * Get the current depth
+         */
+        [[nodiscard]] int GetDepth() const;
+
+        /*
+         * Get a matrix
+         */
+        [[nodiscard]] const TMatrix &GetMatrix(unsigned int index_) const;
+
+        /*
+         * Get the buffer recording on this thread, if any
+         */
+        static RenderCommandBuffer *GetRecording();
+
+        /*
+         * Get a resource
+         */
+        template <typename ResourceType>
+        std::shared_ptr<ResourceType> GetResource(unsigned int index_) const {
+            return std::static_pointer_cast<ResourceType>(_Resources[index_]);
+        }
+
+        /*
+         * Get text
+         */
+        [[nodiscard]] const char *GetText(unsigned int offset_) const;
+
+        /*
+         * Get vertices
+         */
+        [[nodiscard]] const TVector2 *GetVertices(unsigned int offset_) const;
+
+        /*
+         * Set whether or not commands are batched when sorted.
+         * When batching, draws at the same depth are grouped by blend mode and texture,
+         * so overlapping draws at the same depth may change order. Off at the start of each recording.
+         */
+        void SetBatching(bool batching_);
+
+        /*
+         * Set the blend mode of following commands.
+         * Alpha blending at the start of each recording.
+         */
+        void SetBlendMode(EBlendMode mode_);
+
+        /*
+         * Set the depth of following commands.
+         * Higher depths are drawn on top. Clamped to a 16 bit range, 0 at the start of each recording.
+         */
+        void SetDepth(int depth_);
+
+        /*
+         * Sort commands for submission.
+         * This is a stable radix sort, so commands with the same key keep their call order.
+         */
+        void Sort();
+
+        /*
+         * Run the commands with a backend, in sorted order if sorted.
+         * Nested buffers are submitted in place. The buffer can be submitted again.
+         */
+        void Submit(IRenderBackend &backend_) const;
+    };
+}
+
+#endif //RENDERCOMMANDBUFFER_H
@@ -0,0 +1,68 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "InputState.h"
+
+#include "Keyboard.h"
+
+namespace NerdThings::Ngine::Input {
+    // Public Methods
+
+    void TInputState::Accumulate(const TInputState &next_) {
+        KeysDown = next_.KeysDown;
+        KeysPressed |= next_.KeysPressed;
+        KeysReleased |= next_.KeysReleased;
+
+        for (auto i = 0; i < 3; i++) {
+            Mouse.ButtonsDown[i] = next_.Mouse.ButtonsDown[i];
+            Mouse.ButtonsPressed[i] = Mouse.ButtonsPressed[i] || next_.Mouse.ButtonsPressed[i];
+            Mouse.ButtonsReleased[i] = Mouse.ButtonsReleased[i] || next_.Mouse.ButtonsReleased[i];
+        }
+
+        Mouse.MouseWheelMovementY += next_.Mouse.MouseWheelMovementY;
+        Mouse.Position = next_.Mouse.Position;
+    }
+
+    void TInputState::CancelButton(EMouseButton button_) {
+        Mouse.ButtonsDown[button_] = false;
+        Mouse.ButtonsPressed[button_] = false;
+        Mouse.ButtonsReleased[button_] = true;
+    }
+
+    TInputState TInputState::Capture() {
+        TInputState state;
+
+        // Key 0 is KEY_NONE
+        for (auto i = 1; i < static_cast<int>(state.KeysDown.size()); i++) {
+            auto key = static_cast<EKey>(i);
+            state.KeysDown[i] = Keyboard::IsKeyDown(key);
+            state.KeysPressed[i] = Keyboard::IsKeyPressed(key);
+            state.KeysReleased[i] = Keyboard::IsKeyReleased(key);
+        }
+
+        // Use the mouse manager state so cancelled buttons stay cancelled
+        state.Mouse = Mouse::GetMouseState();
+
+        return state;
+    }
+
+    void TInputState::ClearEdges() {
+        KeysPressed.reset();
+        KeysReleased.reset();
+
+        for (auto i = 0; i < 3; i++) {
+            Mouse.ButtonsPressed[i] = false;
+            Mouse.ButtonsReleased[i] = false;
+        }
+
+        Mouse.MouseWheelMovementY = 0;
+    }
+}
@@ -0,0 +1,102 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+#include "../ngine.h"
+
+#include <bitset>
+
+#include "Mouse.h"
+
+namespace NerdThings::Ngine::Input {
+    /*
+     * The number of key codes, KEY_KB_MENU is the highest
+     */
+    static const int KeyCount = KEY_KB_MENU + 1;
+
+    /*
+     * A snapshot of input for one update.
+     * Each scene has its own, so scenes updating on other threads never read the global input.
+     */
+    struct NEAPI TInputState {
+        // Public Fields
+
+        /*
+         * Keys that are down
+         */
+        std::bitset<KeyCount> KeysDown;
+
+        /*
+         * Keys pressed this update
+         */
+        std::bitset<KeyCount> KeysPressed;
+
+        /*
+         * Keys released this update
+         */
+        std::bitset<KeyCount> KeysReleased;
+
+        /*
+         * The mouse state
+         */
+        MouseState Mouse;
+
+        // Public Methods
+
+        /*
+         * Add a newer snapshot to this one.
+         * Held keys, buttons and the mouse position come from the newer snapshot, while presses, releases
+         * and scrolling add up, so none are lost when several snapshots are taken between updates.
+         */
+        void Accumulate(const TInputState &next_);
+
+        /*
+         * Cancel a mouse button press, so nothing else in this update sees it
+         */
+        void CancelButton(EMouseButton button_);
+
+        /*
+         * Capture the current keyboard and mouse state.
+         * Must be called from the main thread.
+         */
+        static TInputState Capture();
+
+        /*
+         * Clear presses, releases and scrolling once they have been delivered
+         */
+        void ClearEdges();
+
+        /*
+         * Is the key down
+         */
+        [[nodiscard]] bool IsKeyDown(EKey key_) const {
+            return key_ < KeysDown.size() && KeysDown[key_];
+        }
+
+        /*
+         * Was the key pressed this update
+         */
+        [[nodiscard]] bool IsKeyPressed(EKey key_) const {
+            return key_ < KeysPressed.size() && KeysPressed[key_];
+        }
+
+        /*
+         * Was the key released this update
+         */
+        [[nodiscard]] bool IsKeyReleased(EKey key_) const {
+            return key_ < KeysReleased.size() && KeysReleased[key_];
+        }
+    };
+}
+
+#endif //INPUTSTATE_H
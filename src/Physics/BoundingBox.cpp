@@ -15,46 +15,32 @@ namespace NerdThings::Ngine::Physics {
     // Private Methods
 
     bool TBoundingBox::IsCompatible(ICollisionShape *shape_) {
-        const auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-
-        // Bounding Box 2D against Bounding Box 2D
-        if (boundingBox2D != nullptr)
-            return true;
-
-        // No support for circle, bb2d against circle implemented in circle struct
-
-        return false;
+        // Every built in shape has a kernel against us
+        return shape_->GetShapeKind() != SHAPE_CUSTOM;
     }
 
     bool TBoundingBox::RunCollisionCheck(ICollisionShape *shape_) {
-        auto collided = false;
-
-        auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-
-        // Bounding Box 2D against Bounding Box 2D
-        auto myAABB = ToB2Shape();
-        if (boundingBox2D != nullptr) {
-            auto theirAABB = boundingBox2D->ToB2Shape();
-            collided = b2TestOverlap(&myAABB, &theirAABB);
-        }
-
-        return collided;
+        return CheckCollision(shape_);
     }
 
     // Public Methods
 
 #ifdef INCLUDE_BOX2D
 
-    b2PolygonShape TBoundingBox::ToB2Shape() {
+    b2PolygonShape TBoundingBox::ToB2Shape() const {
         b2PolygonShape tmpShape;
-        b2Vec2 vertices[4];
-
-        vertices[0] = {Min.X, Min.Y};
-        vertices[1] = {Min.X, Max.Y};
-        vertices[2] = {Max.X, Max.Y};
-        vertices[3] = {Max.X, Min.Y};
 
-        tmpShape.Set(vertices, 4);
+        // Counter-clockwise, as Box2D winds its hulls
+        tmpShape.m_count = 4;
+        tmpShape.m_vertices[0].Set(Min.X, Min.Y);
+        tmpShape.m_vertices[1].Set(Max.X, Min.Y);
+        tmpShape.m_vertices[2].Set(Max.X, Max.Y);
+        tmpShape.m_vertices[3].Set(Min.X, Max.Y);
+        tmpShape.m_normals[0].Set(0, -1);
+        tmpShape.m_normals[1].Set(1, 0);
+        tmpShape.m_normals[2].Set(0, 1);
+        tmpShape.m_normals[3].Set(-1, 0);
+        tmpShape.m_centroid.Set((Min.X + Max.X) * 0.5f, (Min.Y + Max.Y) * 0.5f);
         return tmpShape;
     }
 
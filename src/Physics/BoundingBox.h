@@ -51,8 +51,16 @@ namespace NerdThings::Ngine::Physics {
 
         // Public Methods
 
+        [[nodiscard]] EShapeKind GetShapeKind() const override {
+            return SHAPE_BOUNDING_BOX;
+        }
+
 #ifdef INCLUDE_BOX2D
-        b2PolygonShape ToB2Shape();
+        /*
+         * Build the Box2D shape.
+         * The hull of a box is known, so this is filled directly rather than through b2PolygonShape::Set.
+         */
+        b2PolygonShape ToB2Shape() const;
 #endif
     };
 }
@@ -11,53 +11,22 @@
 
 #include "Circle.h"
 
-#include "BoundingBox.h"
-
 namespace NerdThings::Ngine::Physics {
     // Private Methods
 
     bool TCircle::IsCompatible(ICollisionShape *shape_) {
-        const auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-        const auto circle = dynamic_cast<TCircle*>(shape_);
-
-        // Circle against Circle
-        if (circle != nullptr)
-            return true;
-
-        // Bounding Box 2D against Circle
-        if (boundingBox2D != nullptr)
-            return true;
-
-        return false;
+        // Every built in shape has a kernel against us
+        return shape_->GetShapeKind() != SHAPE_CUSTOM;
     }
 
     bool TCircle::RunCollisionCheck(ICollisionShape *shape_) {
-        auto collided = false;
-
-        auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-        const auto circle = dynamic_cast<TCircle*>(shape_);
-
-        // Circle against Circle
-
-        auto myCircle = ToB2Shape();
-        if (circle != nullptr) {
-            auto theirCircle = circle->ToB2Shape();
-            collided = b2TestOverlap(&myCircle, &theirCircle);
-        }
-
-        // Bounding Box 2D against Circle
-        if (boundingBox2D != nullptr) {
-            auto theirAABB = boundingBox2D->ToB2Shape();
-            collided = b2TestOverlap(&myCircle, &theirAABB);
-        }
-
-        return collided;
+        return CheckCollision(shape_);
     }
 
     // Public Methods
 
 #ifdef INCLUDE_BOX2D
-    b2CircleShape TCircle::ToB2Shape() {
+    b2CircleShape TCircle::ToB2Shape() const {
         b2CircleShape shape;
         shape.m_p.Set(Center.X, Center.Y);
         shape.m_radius = Radius;
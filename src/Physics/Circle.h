@@ -54,8 +54,12 @@ namespace NerdThings::Ngine::Physics {
 
         // Public Methods
 
+        [[nodiscard]] EShapeKind GetShapeKind() const override {
+            return SHAPE_CIRCLE;
+        }
+
 #ifdef INCLUDE_BOX2D
-        b2CircleShape ToB2Shape();
+        b2CircleShape ToB2Shape() const;
 #endif
     };
 }
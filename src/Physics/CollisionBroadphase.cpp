@@ -0,0 +1,69 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "CollisionBroadphase.h"
+
+namespace NerdThings::Ngine::Physics {
+    /*
+     * Convert a bounding box to a Box2D AABB
+     */
+    static b2AABB ToB2AABB(const TBoundingBox &bounds_) {
+        b2AABB aabb;
+        aabb.lowerBound = {bounds_.Min.X, bounds_.Min.Y};
+        aabb.upperBound = {bounds_.Max.X, bounds_.Max.Y};
+        return aabb;
+    }
+
+    // Private Methods
+
+    void CollisionBroadphase::RunQuery(const TBoundingBox &bounds_, bool (*callback_)(void *, void *),
+                                       void *context_) const {
+        // Box2D wants an object with a QueryCallback method
+        struct TQuery {
+            const b2DynamicTree *Tree;
+            bool (*Callback)(void *, void *);
+            void *Context;
+
+            bool QueryCallback(int32 proxy_) {
+                return Callback(Tree->GetUserData(proxy_), Context);
+            }
+        } query = {_Tree.get(), callback_, context_};
+
+        _Tree->Query(&query, ToB2AABB(bounds_));
+    }
+
+    // Public Constructor(s)
+
+    CollisionBroadphase::CollisionBroadphase()
+        : _Tree(std::make_unique<b2DynamicTree>()) {}
+
+    // Destructor
+
+    CollisionBroadphase::~CollisionBroadphase() = default;
+
+    // Public Methods
+
+    int CollisionBroadphase::CreateProxy(const TBoundingBox &bounds_, void *userData_) {
+        return _Tree->CreateProxy(ToB2AABB(bounds_), userData_);
+    }
+
+    void CollisionBroadphase::DestroyProxy(int proxy_) {
+        _Tree->DestroyProxy(proxy_);
+    }
+
+    void *CollisionBroadphase::GetUserData(int proxy_) const {
+        return _Tree->GetUserData(proxy_);
+    }
+
+    void CollisionBroadphase::MoveProxy(int proxy_, const TBoundingBox &bounds_, TVector2 displacement_) {
+        _Tree->MoveProxy(proxy_, ToB2AABB(bounds_), {displacement_.X, displacement_.Y});
+    }
+}
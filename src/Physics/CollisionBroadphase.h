@@ -0,0 +1,92 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef COLLISIONBROADPHASE_H
+#define COLLISIONBROADPHASE_H
+
+#include "../ngine.h"
+
+#include "Vector2.h"
+#include "BoundingBox.h"
+
+// Box2D is not exposed to games, so the tree is kept behind a pointer
+class b2DynamicTree;
+
+namespace NerdThings::Ngine::Physics {
+    /*
+     * Collision broadphase.
+     * This is a dynamic AABB tree used to find which shapes could be colliding before running exact checks.
+     */
+    class NEAPI CollisionBroadphase {
+        // Private Fields
+
+        /*
+         * The Box2D tree
+         */
+        std::unique_ptr<b2DynamicTree> _Tree;
+
+        // Private Methods
+
+        /*
+         * Run a query.
+         * callback_ is called with each proxy's user data and context_, return false to stop.
+         */
+        void RunQuery(const TBoundingBox &bounds_, bool (*callback_)(void *userData_, void *context_),
+                      void *context_) const;
+    public:
+        // Public Constructor(s)
+
+        CollisionBroadphase();
+
+        CollisionBroadphase(const CollisionBroadphase &broadphase_) = delete;
+
+        // Destructor
+
+        ~CollisionBroadphase();
+
+        // Public Methods
+
+        /*
+         * Add a proxy to the tree.
+         * Returns the proxy ID.
+         */
+        int CreateProxy(const TBoundingBox &bounds_, void *userData_);
+
+        /*
+         * Remove a proxy from the tree
+         */
+        void DestroyProxy(int proxy_);
+
+        /*
+         * Get the user data of a proxy
+         */
+        [[nodiscard]] void *GetUserData(int proxy_) const;
+
+        /*
+         * Move a proxy.
+         * The tree is only restructured if the proxy leaves its enlarged bounds.
+         */
+        void MoveProxy(int proxy_, const TBoundingBox &bounds_, TVector2 displacement_);
+
+        /*
+         * Find all proxies that may overlap the bounds.
+         * func_ is called with the proxy user data, return false to stop the query.
+         */
+        template <typename Func>
+        void Query(const TBoundingBox &bounds_, Func func_) const {
+            RunQuery(bounds_, [](void *userData_, void *context_) {
+                return (*static_cast<Func *>(context_))(userData_);
+            }, &func_);
+        }
+    };
+}
+
+#endif //COLLISIONBROADPHASE_H
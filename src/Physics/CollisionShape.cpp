@@ -0,0 +1,133 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "CollisionShape.h"
+
+#include "BoundingBox.h"
+#include "Circle.h"
+#include "Polygon.h"
+
+namespace NerdThings::Ngine::Physics {
+    /*
+     * A collision test between two shapes of known kinds
+     */
+    typedef bool (*CollisionKernel)(ICollisionShape *, ICollisionShape *);
+
+    /*
+     * Box2D reports an overlap once the distance between two shapes, less their radii, falls below this.
+     * The closed form tests use the same threshold so they agree with b2TestOverlap.
+     */
+    static const float OverlapTolerance = 10.0f * b2_epsilon;
+
+    /*
+     * Squared distance between two boxes, 0 if they intersect
+     */
+    static float BoxBoxDistanceSquared(const TBoundingBox &a_, const TBoundingBox &b_) {
+        auto dx = std::max(0.0f, std::max(a_.Min.X - b_.Max.X, b_.Min.X - a_.Max.X));
+        auto dy = std::max(0.0f, std::max(a_.Min.Y - b_.Max.Y, b_.Min.Y - a_.Max.Y));
+        return dx * dx + dy * dy;
+    }
+
+    /*
+     * Squared distance between a point and a box, 0 if inside
+     */
+    static float BoxPointDistanceSquared(const TBoundingBox &box_, TVector2 point_) {
+        auto dx = std::max(0.0f, std::max(box_.Min.X - point_.X, point_.X - box_.Max.X));
+        auto dy = std::max(0.0f, std::max(box_.Min.Y - point_.Y, point_.Y - box_.Max.Y));
+        return dx * dx + dy * dy;
+    }
+
+    /*
+     * Whether a distance is within a combined radius, using the Box2D threshold
+     */
+    static bool WithinRadius(float distanceSquared_, float radius_) {
+        auto limit = radius_ + OverlapTolerance;
+        return distanceSquared_ < limit * limit;
+    }
+
+    static bool BoxBoxKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        // Boxes carry the polygon skin, the same as their Box2D shapes
+        return WithinRadius(BoxBoxDistanceSquared(*static_cast<TBoundingBox *>(a_), *static_cast<TBoundingBox *>(b_)),
+                            2.0f * b2_polygonRadius);
+    }
+
+    static bool BoxCircleKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        auto circle = static_cast<TCircle *>(b_);
+        return WithinRadius(BoxPointDistanceSquared(*static_cast<TBoundingBox *>(a_), circle->Center),
+                            circle->Radius + b2_polygonRadius);
+    }
+
+    static bool CircleCircleKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        auto a = static_cast<TCircle *>(a_);
+        auto b = static_cast<TCircle *>(b_);
+        auto dx = b->Center.X - a->Center.X;
+        auto dy = b->Center.Y - a->Center.Y;
+        return WithinRadius(dx * dx + dy * dy, a->Radius + b->Radius);
+    }
+
+    static bool PolygonBoxKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        auto a = static_cast<TPolygon *>(a_)->ToB2Shape();
+        auto b = static_cast<TBoundingBox *>(b_)->ToB2Shape();
+        return b2TestOverlap(&a, &b);
+    }
+
+    static bool PolygonCircleKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        auto a = static_cast<TPolygon *>(a_)->ToB2Shape();
+        auto b = static_cast<TCircle *>(b_)->ToB2Shape();
+        return b2TestOverlap(&a, &b);
+    }
+
+    static bool PolygonPolygonKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        auto a = static_cast<TPolygon *>(a_)->ToB2Shape();
+        auto b = static_cast<TPolygon *>(b_)->ToB2Shape();
+        return b2TestOverlap(&a, &b);
+    }
+
+    /*
+     * Run a kernel with its arguments swapped
+     */
+    template <CollisionKernel Kernel>
+    static bool SwappedKernel(ICollisionShape *a_, ICollisionShape *b_) {
+        return Kernel(b_, a_);
+    }
+
+    /*
+     * Collision kernels, indexed by the kinds of the two shapes
+     */
+    static const CollisionKernel CollisionKernels[SHAPE_KIND_COUNT][SHAPE_KIND_COUNT] = {
+        // SHAPE_CUSTOM
+        {nullptr, nullptr, nullptr, nullptr},
+        // SHAPE_BOUNDING_BOX
+        {nullptr, BoxBoxKernel, BoxCircleKernel, SwappedKernel<PolygonBoxKernel>},
+        // SHAPE_CIRCLE
+        {nullptr, SwappedKernel<BoxCircleKernel>, CircleCircleKernel, SwappedKernel<PolygonCircleKernel>},
+        // SHAPE_POLYGON
+        {nullptr, PolygonBoxKernel, PolygonCircleKernel, PolygonPolygonKernel},
+    };
+
+    // Public Methods
+
+    bool ICollisionShape::CheckCollision(ICollisionShape *shape_) {
+        auto kernel = CollisionKernels[GetShapeKind()][shape_->GetShapeKind()];
+        if (kernel != nullptr) {
+            return kernel(this, shape_);
+        }
+
+        // Custom shapes decide for themselves
+        if (IsCompatible(shape_)) {
+            return RunCollisionCheck(shape_);
+        }
+        if (shape_->IsCompatible(this)) {
+            return shape_->RunCollisionCheck(this);
+        }
+        throw std::runtime_error("Two shapes are unable to collide with each other!");
+    }
+}
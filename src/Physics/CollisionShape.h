@@ -12,13 +12,46 @@
 #ifndef COLLISIONSHAPE_H
 #define COLLISIONSHAPE_H
 
+#include "../ngine.h"
+
 #include "Vector2.h"
 
 namespace NerdThings::Ngine::Physics {
+    /*
+     * Built in collision shape kinds.
+     * Used to pick a collision kernel without casting.
+     */
+    enum EShapeKind {
+        /*
+         * A user shape, checked through IsCompatible and RunCollisionCheck
+         */
+        SHAPE_CUSTOM = 0,
+
+        /*
+         * TBoundingBox
+         */
+        SHAPE_BOUNDING_BOX,
+
+        /*
+         * TCircle
+         */
+        SHAPE_CIRCLE,
+
+        /*
+         * TPolygon
+         */
+        SHAPE_POLYGON,
+
+        /*
+         * The number of shape kinds
+         */
+        SHAPE_KIND_COUNT
+    };
+
     /*
      * A collision shape interface
      */
-    struct ICollisionShape {
+    struct NEAPI ICollisionShape {
     private:
         // Private Methods
 
@@ -37,19 +70,19 @@ namespace NerdThings::Ngine::Physics {
 
         virtual ~ICollisionShape() = default;
 
-        // Public fields
+        // Public Methods
 
         /*
          * Check collision against another collision shape.
+         * Built in shape pairs are dispatched straight to their collision kernel.
+         */
+        bool CheckCollision(ICollisionShape *shape_);
+
+        /*
+         * Get the kind of shape this is
          */
-        bool CheckCollision(ICollisionShape *shape_) {
-            if (IsCompatible(shape_)) {
-                return RunCollisionCheck(shape_);
-            }
-            if (shape_->IsCompatible(this)) {
-                return shape_->RunCollisionCheck(this);
-            }
-            throw std::runtime_error("Two shapes are unable to collide with each other!");
+        [[nodiscard]] virtual EShapeKind GetShapeKind() const {
+            return SHAPE_CUSTOM;
         }
     };
 }
@@ -11,66 +11,80 @@
 
 #include "Polygon.h"
 
-#include "BoundingBox.h"
-#include "Circle.h"
+#include <cmath>
 
 namespace NerdThings::Ngine::Physics {
     // Private Methods
 
     bool TPolygon::IsCompatible(ICollisionShape *shape_) {
-        const auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-        const auto circle = dynamic_cast<TCircle*>(shape_);
-        const auto polygon = dynamic_cast<TPolygon*>(shape_);
-
-        if (boundingBox2D != nullptr)
-            return true;
-        if (circle != nullptr)
-            return true;
-        if (polygon != nullptr)
-            return true;
-        return false;
+        // Every built in shape has a kernel against us
+        return shape_->GetShapeKind() != SHAPE_CUSTOM;
     }
 
     bool TPolygon::RunCollisionCheck(ICollisionShape *shape_) {
-        auto collided = false;
-
-        const auto boundingBox2D = dynamic_cast<TBoundingBox*>(shape_);
-        const auto circle = dynamic_cast<TCircle*>(shape_);
-        const auto polygon = dynamic_cast<TPolygon*>(shape_);
-
-        auto myPoly = ToB2Shape();
-
-        if (boundingBox2D != nullptr) {
-            auto theirAABB = boundingBox2D->ToB2Shape();
-            collided = b2TestOverlap(&myPoly, &theirAABB);
-        } else if (circle != nullptr) {
-            auto theirCircle = circle->ToB2Shape();
-            collided = b2TestOverlap(&myPoly, &theirCircle);
-        } else if (polygon != nullptr) {
-            auto theirPoly = polygon->ToB2Shape();
-            collided = b2TestOverlap(&myPoly, &theirPoly);
-        }
-
-        return collided;
+        return CheckCollision(shape_);
     }
 
     // Public Methods
 
 #ifdef INCLUDE_BOX2D
-    b2PolygonShape TPolygon::ToB2Shape() {
+    b2PolygonShape TPolygon::ToB2Shape() const {
+        // Fill from the cache, b2PolygonShape::Set would recompute the hull
         b2PolygonShape tmpShape;
-        b2Vec2 vertices[b2_maxPolygonVertices];
-        for (auto i = 0; i < VertexCount; i++) vertices[i] = {Vertices[i].X, Vertices[i].Y};
-        tmpShape.Set(vertices, VertexCount);
+        tmpShape.m_count = _HullCount;
+        for (auto i = 0; i < _HullCount; i++) {
+            tmpShape.m_vertices[i].Set(_HullVertices[i].X, _HullVertices[i].Y);
+            tmpShape.m_normals[i].Set(Normals[i].X, Normals[i].Y);
+        }
+        tmpShape.m_centroid.Set(_HullCentroid.X, _HullCentroid.Y);
         return tmpShape;
     }
 #endif
 
     void TPolygon::GenerateNormals() {
-        // Create c2 poly
-        auto tmpPoly = ToB2Shape();
+        // Let Box2D compute the hull once
+        b2PolygonShape tmpPoly;
+        b2Vec2 vertices[b2_maxPolygonVertices];
+        for (auto i = 0; i < VertexCount; i++) vertices[i] = {Vertices[i].X, Vertices[i].Y};
+        tmpPoly.Set(vertices, VertexCount);
+
+        // Cache the hull and bring in normals
+        _HullCount = tmpPoly.m_count;
+        for (auto i = 0; i < _HullCount; i++) {
+            _HullVertices[i] = {tmpPoly.m_vertices[i].x, tmpPoly.m_vertices[i].y};
+            Normals[i] = {tmpPoly.m_normals[i].x, tmpPoly.m_normals[i].y};
+        }
+        _HullCentroid = {tmpPoly.m_centroid.x, tmpPoly.m_centroid.y};
+    }
+
+    void TPolygon::Rotate(TVector2 center_, float rotation_) {
+        if (rotation_ == 0) return;
+
+        // Only work out the rotation once
+        const auto s = sinf(rotation_);
+        const auto c = cosf(rotation_);
+
+        auto rotatePoint = [&](TVector2 &point_) {
+            const auto x = point_.X - center_.X;
+            const auto y = point_.Y - center_.Y;
+            point_.X = x * c - y * s + center_.X;
+            point_.Y = x * s + y * c + center_.Y;
+        };
+
+        for (auto i = 0; i < VertexCount; i++) rotatePoint(Vertices[i]);
+        for (auto i = 0; i < _HullCount; i++) {
+            rotatePoint(_HullVertices[i]);
+
+            // Normals are directions, they only rotate
+            const auto n = Normals[i];
+            Normals[i] = TVector2(n.X * c - n.Y * s, n.X * s + n.Y * c);
+        }
+        rotatePoint(_HullCentroid);
+    }
 
-        // Bring in normals
-        for (auto i = 0; i < VertexCount; i++) Normals[i] = {tmpPoly.m_normals[i].x, tmpPoly.m_normals[i].y};
+    void TPolygon::Translate(TVector2 offset_) {
+        for (auto i = 0; i < VertexCount; i++) Vertices[i] += offset_;
+        for (auto i = 0; i < _HullCount; i++) _HullVertices[i] += offset_;
+        _HullCentroid += offset_;
     }
 }
@@ -22,6 +22,24 @@
 namespace NerdThings::Ngine::Physics {
     struct NEAPI TPolygon : public ICollisionShape {
     private:
+        // Private Fields
+
+        /*
+         * Cached hull centroid
+         */
+        TVector2 _HullCentroid;
+
+        /*
+         * Cached hull vertex count.
+         * The hull may drop vertices that are not convex.
+         */
+        unsigned int _HullCount = 0;
+
+        /*
+         * Cached hull vertices, in Box2D winding
+         */
+        TVector2 _HullVertices[MAX_POLY_VERTS];
+
         // Private Methods
 
         bool IsCompatible(ICollisionShape *shape_) override;
@@ -72,14 +90,34 @@ namespace NerdThings::Ngine::Physics {
 
         // Public Methods
 
+        [[nodiscard]] EShapeKind GetShapeKind() const override {
+            return SHAPE_POLYGON;
+        }
+
 #ifdef INCLUDE_BOX2D
-        b2PolygonShape ToB2Shape();
+        /*
+         * Build the Box2D shape from the cached hull
+         */
+        b2PolygonShape ToB2Shape() const;
 #endif
 
         /*
-         * Generate normals
+         * Generate normals and rebuild the cached hull.
+         * Must be called whenever Vertices are changed.
          */
         void GenerateNormals();
+
+        /*
+         * Rotate the polygon around a point.
+         * The cached hull is rotated with it, so it does not need regenerating.
+         */
+        void Rotate(TVector2 center_, float rotation_);
+
+        /*
+         * Move the polygon.
+         * The cached hull is moved with it, so it does not need regenerating.
+         */
+        void Translate(TVector2 offset_);
     };
 }
 
@@ -31,18 +31,23 @@
 #endif
 
 #include <filesystem>
+#include <mutex>
+
+#include "Diagnostics/Profiler.h"
 
 namespace NerdThings::Ngine {
     // Private Fields
 
     std::unordered_map<std::string, std::shared_ptr<Graphics::TFont>> Resources::_Fonts;
     std::unordered_map<std::string, std::shared_ptr<Audio::TMusic>> Resources::_Music;
+    std::shared_mutex Resources::_Mutex;
     std::unordered_map<std::string, std::shared_ptr<Audio::TSound>> Resources::_Sounds;
     std::unordered_map<std::string, std::shared_ptr<Graphics::TTexture2D>> Resources::_Textures;
 
     // Public Methods
 
     void Resources::DeleteAll() {
+        std::unique_lock<std::shared_mutex> lock(_Mutex);
         _Fonts.clear();
         _Music.clear();
         _Sounds.clear();
@@ -50,24 +55,28 @@ namespace NerdThings::Ngine {
     }
 
     void Resources::DeleteFont(const std::string &name_) {
+        std::unique_lock<std::shared_mutex> lock(_Mutex);
         if (_Fonts.find(name_) != _Fonts.end()) {
             _Fonts.erase(name_);
         }
     }
 
     void Resources::DeleteMusic(const std::string &name_) {
+        std::unique_lock<std::shared_mutex> lock(_Mutex);
         if (_Music.find(name_) != _Music.end()) {
             _Music.erase(name_);
         }
     }
 
     void Resources::DeleteSound(const std::string &name_) {
+        std::unique_lock<std::shared_mutex> lock(_Mutex);
         if (_Sounds.find(name_) != _Sounds.end()) {
             _Sounds.erase(name_);
         }
     }
 
     void Resources::DeleteTexture(const std::string &name_) {
+        std::unique_lock<std::shared_mutex> lock(_Mutex);
         if (_Textures.find(name_) != _Textures.end()) {
             _Textures.erase(name_);
         }
@@ -167,26 +176,34 @@ namespace NerdThings::Ngine {
     }
 
     std::shared_ptr<Graphics::TFont> Resources::GetFont(const std::string &name_) {
-        if (_Fonts.find(name_) != _Fonts.end())
-            return _Fonts[name_];
+        std::shared_lock<std::shared_mutex> lock(_Mutex);
+        auto it = _Fonts.find(name_);
+        if (it != _Fonts.end())
+            return it->second;
         return nullptr;
     }
 
     std::shared_ptr<Audio::TMusic> Resources::GetMusic(const std::string &name_) {
-        if (_Music.find(name_) != _Music.end())
-            return _Music[name_];
+        std::shared_lock<std::shared_mutex> lock(_Mutex);
+        auto it = _Music.find(name_);
+        if (it != _Music.end())
+            return it->second;
         return nullptr;
     }
 
     std::shared_ptr<Audio::TSound> Resources::GetSound(const std::string &name_) {
-        if (_Sounds.find(name_) != _Sounds.end())
-            return _Sounds[name_];
+        std::shared_lock<std::shared_mutex> lock(_Mutex);
+        auto it = _Sounds.find(name_);
+        if (it != _Sounds.end())
+            return it->second;
         return nullptr;
     }
 
     std::shared_ptr<Graphics::TTexture2D> Resources::GetTexture(const std::string &name_) {
-        if (_Textures.find(name_) != _Textures.end())
-            return _Textures[name_];
+        std::shared_lock<std::shared_mutex> lock(_Mutex);
+        auto it = _Textures.find(name_);
+        if (it != _Textures.end())
+            return it->second;
         return nullptr;
     }
 
@@ -195,6 +212,8 @@ namespace NerdThings::Ngine {
     }
 
     void Resources::LoadDirectory(const std::string &directory_) {
+        NGINE_PROFILE_SCOPE("Resources::LoadDirectory");
+
         std::vector<std::string> files;
 
         // Get all files
@@ -231,8 +250,11 @@ namespace NerdThings::Ngine {
     }
 
     bool Resources::LoadFont(const std::string &inPath_, const std::string &name_) {
+        NGINE_PROFILE_SCOPE("Resources::LoadFont");
+
         auto fnt = Graphics::TFont::LoadFont(inPath_);
         if (fnt->Texture->ID > 0) {
+            std::unique_lock<std::shared_mutex> lock(_Mutex);
             _Fonts.insert({ name_, fnt });
             return true;
         }
@@ -240,8 +262,11 @@ namespace NerdThings::Ngine {
     }
 
     bool Resources::LoadMusic(const std::string &inPath_, const std::string &name_) {
+        NGINE_PROFILE_SCOPE("Resources::LoadMusic");
+
         auto mus = Audio::TMusic::LoadMusic(inPath_);
         if (mus->MusicData != nullptr) {
+            std::unique_lock<std::shared_mutex> lock(_Mutex);
             _Music.insert({ name_, mus });
             return true;
         }
@@ -249,8 +274,11 @@ namespace NerdThings::Ngine {
     }
 
     bool Resources::LoadSound(const std::string &inPath_, const std::string &name_) {
+        NGINE_PROFILE_SCOPE("Resources::LoadSound");
+
         auto snd = Audio::TSound::LoadSound(inPath_);
         if (snd->AudioBuffer != nullptr) {
+            std::unique_lock<std::shared_mutex> lock(_Mutex);
             _Sounds.insert({ name_, snd });
             return true;
         }
@@ -258,8 +286,11 @@ namespace NerdThings::Ngine {
     }
 
     bool Resources::LoadTexture(const std::string &inPath_, const std::string &name_) {
+        NGINE_PROFILE_SCOPE("Resources::LoadTexture");
+
         auto tex = Graphics::TTexture2D::LoadTexture(inPath_);
         if (tex->ID > 0) {
+            std::unique_lock<std::shared_mutex> lock(_Mutex);
             _Textures.insert({ name_, tex });
             return true;
         }
@@ -14,6 +14,8 @@
 
 #include "ngine.h"
 
+#include <shared_mutex>
+
 #include "Audio/Music.h"
 #include "Audio/Sound.h"
 #include "Graphics/Font.h"
@@ -33,6 +35,12 @@ namespace NerdThings::Ngine {
          */
         static std::unordered_map<std::string, std::shared_ptr<Audio::TMusic>> _Music;
 
+        /*
+         * Lock for the resource maps.
+         * Scenes updating in parallel may look resources up at the same time.
+         */
+        static std::shared_mutex _Mutex;
+
         /*
          * All named sounds
          */
@@ -15,26 +15,225 @@
 #include "Scene.h"
 
 #include "BaseEntity.h"
+#include "Diagnostics/Profiler.h"
 #include "Game.h"
 
 namespace NerdThings::Ngine {
     // Private Methods
 
-    // The following two functions do nothing
-    // This method is here for adding an entity parent
-    void Scene::RemoveEntityParent(BaseEntity *ent_) {
-        for (auto vec : _EntityDepths) {
-            for (auto ent : vec.second) {
-                if (ent == ent_) {
-                    _EntityDepths[vec.first].erase(std::remove(_EntityDepths[vec.first].begin(), _EntityDepths[vec.first].end(), ent_), _EntityDepths[vec.first].end());
-                }
+    void Scene::BuildSystemWaves() {
+        _SystemWaves.clear();
+
+        std::vector<size_t> waveOf(_Systems.size());
+        for (size_t i = 0; i < _Systems.size(); i++) {
+            size_t wave = 0;
+            for (size_t j = 0; j < i; j++) {
+                if (_Systems[i]->ConflictsWith(*_Systems[j]))
+                    wave = std::max(wave, waveOf[j] + 1);
             }
+
+            waveOf[i] = wave;
+            if (wave >= _SystemWaves.size())
+                _SystemWaves.resize(wave + 1);
+            _SystemWaves[wave].push_back(_Systems[i].get());
+        }
+
+        _SystemWavesDirty = false;
+    }
+
+    void Scene::CullEntities() {
+        NGINE_PROFILE_SCOPE("Scene::CullEntities");
+
+        // The cull area follows the camera
+        if (_ActiveCamera == nullptr) {
+            // Nothing rebuilds the list without a camera, so drop released entities once they pile up
+            if (_CullActiveReleased * 2 > _CullActive.size()) {
+                _CullActive.erase(std::remove_if(_CullActive.begin(), _CullActive.end(), [&](const EntityHandle &handle_) {
+                    return !IsEntityValid(handle_);
+                }), _CullActive.end());
+                _CullActiveReleased = 0;
+            }
+            return;
+        }
+
+        _CullStamp++;
+
+        // Only compute this once
+        auto area = GetCullArea();
+
+        // Anything near the cull area might have become active
+        _CullCandidates.clear();
+        _SpatialIndex.QueryRect(area, _CullCandidates);
+
+        _CullNextActive.clear();
+
+        for (auto ent : _CullCandidates) {
+            if (CullEntity(ent, area))
+                _CullNextActive.push_back(ent->GetHandle());
+        }
+
+        // Anything active last pass might have left it
+        for (auto handle : _CullActive) {
+            auto ent = GetEntity(handle);
+            if (ent == nullptr)
+                continue;
+
+            _EntitySlots[handle.Index].CullListed = false;
+            if (CullEntity(ent, area))
+                _CullNextActive.push_back(handle);
+        }
+
+        // Each entity is only checked once a pass, so the new list has no duplicates
+        for (auto handle : _CullNextActive) {
+            _EntitySlots[handle.Index].CullListed = true;
         }
+
+        std::swap(_CullActive, _CullNextActive);
+        _CullActiveReleased = 0;
+    }
+
+    bool Scene::CullEntity(BaseEntity *ent_, TRectangle cullArea_) {
+        auto &slot = _EntitySlots[ent_->GetHandle().Index];
+
+        // Only check once per pass and only check cullable entities
+        if (slot.CullStamp == _CullStamp || !ent_->GetCanCull())
+            return false;
+        slot.CullStamp = _CullStamp;
+
+        auto record = FindDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera());
+        if (record == nullptr)
+            return false;
+
+        record->Active = !ent_->CheckForCulling(cullArea_);
+        return record->Active;
+    }
+
+    void Scene::CompactDrawList() {
+        if (_DrawListRemoved == 0 || _Drawing)
+            return;
+
+        _DrawList.erase(std::remove_if(_DrawList.begin(), _DrawList.end(), [](const TDrawRecord &r_) {
+            return r_.Entity == nullptr;
+        }), _DrawList.end());
+        _DrawListRemoved = 0;
+    }
+
+    TDrawRecord *Scene::FindDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_) {
+        const auto &slot = _EntitySlots[ent_->GetHandle().Index];
+        if (!slot.Drawn)
+            return nullptr;
+
+        TDrawRecord key;
+        key.DrawWithCamera = drawWithCamera_;
+        key.Depth = depth_;
+        key.Sequence = slot.DrawSequence;
+
+        auto it = std::lower_bound(_DrawList.begin(), _DrawList.end(), key);
+        if (it != _DrawList.end() && it->Entity == ent_)
+            return &*it;
+
+        // It may have been inserted during this draw
+        for (auto &record : _DrawListPending) {
+            if (record.Entity == ent_ && record.Sequence == slot.DrawSequence)
+                return &record;
+        }
+        return nullptr;
+    }
+
+    void Scene::FlushTransformChanges() {
+        // Anything changed by a listener now is left for the next update
+        std::swap(_DirtyTransforms, _FlushingTransforms);
+
+        for (auto handle : _FlushingTransforms) {
+            auto ent = GetEntity(handle);
+            if (ent != nullptr)
+                ent->InternalFlushTransformChanged();
+        }
+
+        _FlushingTransforms.clear();
+    }
+
+    void Scene::InsertDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_, bool active_) {
+        auto &slot = _EntitySlots[ent_->GetHandle().Index];
+
+        TDrawRecord record;
+        record.Active = active_;
+        record.DrawWithCamera = drawWithCamera_;
+        record.Depth = depth_;
+        record.Sequence = _DrawSequence++;
+        record.Entity = ent_;
+
+        if (_Drawing) {
+            // Inserting now would shift records under the sweep
+            _DrawListPending.push_back(record);
+        } else {
+            // New records have the highest sequence, so this is usually an append
+            _DrawList.insert(std::upper_bound(_DrawList.begin(), _DrawList.end(), record), record);
+        }
+
+        slot.Drawn = true;
+        slot.DrawSequence = record.Sequence;
+    }
+
+    void Scene::RemoveDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_) {
+        auto record = FindDrawRecord(ent_, depth_, drawWithCamera_);
+        if (record == nullptr)
+            return;
+
+        // Leave it in place until the next draw so removal stays cheap
+        record->Entity = nullptr;
+        _DrawListRemoved++;
+
+        _EntitySlots[ent_->GetHandle().Index].Drawn = false;
+
+        // Don't let removed records pile up if we aren't drawing
+        if (_DrawListRemoved > _DrawList.size() / 2)
+            CompactDrawList();
+    }
+
+    void Scene::RunSystems() {
+        if (_Systems.empty())
+            return;
+
+        NGINE_PROFILE_SCOPE("Scene::RunSystems");
+
+        if (_SystemWavesDirty)
+            BuildSystemWaves();
+
+        auto &jobs = _ParentGame->GetJobSystem();
+
+        // Nobody may change archetypes under a running system
+        ComponentStorageLock lock(_ComponentStorage);
+
+        for (const auto &wave : _SystemWaves) {
+            if (wave.size() == 1) {
+                wave[0]->Run(_ComponentStorage);
+                continue;
+            }
+
+            jobs.ParallelFor(wave.size(), 1, [&](size_t start_, size_t end_) {
+                for (auto i = start_; i < end_; i++) {
+                    wave[i]->Run(_ComponentStorage);
+                }
+            });
+        }
+    }
+
+    void Scene::RemoveEntityParent(BaseEntity *ent_) {
+        // Stop drawing the entity
+        RemoveDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera());
     }
 
     void Scene::SetEntityParent(BaseEntity *ent_) {
         // When an entity is added, mark as active
-        _EntityActivities.insert({ent_, true});
+        auto record = FindDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera());
+        if (record != nullptr)
+            record->Active = true;
+        else InsertDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera(), true);
+
+        // The entity is fully constructed now, so get its real bounds
+        InternalUpdateEntityBounds(ent_);
+        InternalQueueEntityCull(ent_);
     }
 
     // Public Constructor(s)
@@ -51,6 +250,13 @@ namespace NerdThings::Ngine {
 
     Scene::~Scene() {
         ConsoleMessage("Deleting entities.", "NOTICE", "SCENE");
+
+        // Drop the draw list up front so entities are not removed one by one
+        _DrawList.clear();
+        for (auto &slot : _EntitySlots) {
+            slot.Drawn = false;
+        }
+
         for (auto ent : GetEntities()) {
             delete ent;
         }
@@ -58,49 +264,107 @@ namespace NerdThings::Ngine {
 
     // Public Methods
 
-    void Scene::Draw() {
+    SceneSystem *Scene::AddSystem(std::unique_ptr<SceneSystem> system_) {
+        _Systems.push_back(std::move(system_));
+        _SystemWavesDirty = true;
+        return _Systems.back().get();
+    }
+
+    void Scene::Draw(float alpha_) {
+        NGINE_PROFILE_SCOPE("Scene::Draw");
+
+        _InterpolationAlpha = alpha_;
+
         // Invoke draw calls
         OnDraw({});
 
+        // Compact removed records
+        CompactDrawList();
+
         // Draw with camera
         if (_ActiveCamera != nullptr)
             _ActiveCamera->BeginCamera();
 
         OnDrawCamera({});
 
-        // Draw entities with camera
-        for (auto pair : _EntityDepths) {
-            auto vec = pair.second;
-            for (auto ent : vec) {
-                if (ent != nullptr) {
-                    if (_EntityActivities[ent] && ent->DrawWithCamera)
-                        ent->Draw();
-                }
-            }
+        // Camera entities are sorted first, so this is one sweep.
+        // Entities may be destroyed, moved or added by a draw, so the list is held still until it ends.
+        _Drawing = true;
+        size_t i = 0;
+
+        for (; i < _DrawList.size() && _DrawList[i].DrawWithCamera; i++) {
+            const auto &record = _DrawList[i];
+            if (record.Active && record.Entity != nullptr)
+                record.Entity->InternalDraw();
         }
 
         if (_ActiveCamera != nullptr)
             _ActiveCamera->EndCamera();
 
         // Draw entities
-        for (auto pair : _EntityDepths) {
-            auto vec = pair.second;
-            for (auto ent : vec) {
-                if (ent != nullptr) {
-                    if (_EntityActivities.find(ent) == _EntityActivities.end())
-                        _EntityActivities.insert({ent, true});
-
-                    if (_EntityActivities[ent] && !ent->DrawWithCamera)
-                        ent->Draw();
-                }
-            }
+        for (; i < _DrawList.size(); i++) {
+            const auto &record = _DrawList[i];
+            if (record.Active && record.Entity != nullptr)
+                record.Entity->InternalDraw();
+        }
+
+        _Drawing = false;
+
+        // Apply changes made while drawing
+        for (const auto &record : _DrawListPending) {
+            _DrawList.insert(std::upper_bound(_DrawList.begin(), _DrawList.end(), record), record);
         }
+        _DrawListPending.clear();
+        CompactDrawList();
+
+        OnDrawFinished({});
+
+        _InterpolationAlpha = 1;
+    }
+
+    unsigned int Scene::FindCollisionLayerMask(const std::string &name_) const {
+        auto it = _CollisionLayers.find(name_);
+        if (it == _CollisionLayers.end())
+            return 0;
+        return 1u << it->second;
     }
 
     Graphics::TCamera *Scene::GetActiveCamera() const {
         return _ActiveCamera;
     }
 
+    Physics::CollisionBroadphase &Scene::GetCollisionBroadphase() {
+        return _CollisionBroadphase;
+    }
+
+    unsigned int Scene::GetCollisionLayer(const std::string &name_) {
+        auto it = _CollisionLayers.find(name_);
+        if (it != _CollisionLayers.end())
+            return it->second;
+
+        if (_CollisionLayerNames.size() >= MAX_COLLISION_LAYERS) {
+            ConsoleMessage("Ran out of collision layers when adding \"" + name_ + "\".", "FATAL", "SCENE");
+            throw std::runtime_error("Too many collision layers.");
+        }
+
+        auto layer = static_cast<unsigned int>(_CollisionLayerNames.size());
+        _CollisionLayers.insert({name_, layer});
+        _CollisionLayerNames.push_back(name_);
+        return layer;
+    }
+
+    unsigned int Scene::GetCollisionLayerMask(const std::string &name_) {
+        return 1u << GetCollisionLayer(name_);
+    }
+
+    const std::string &Scene::GetCollisionLayerName(unsigned int layer_) const {
+        return _CollisionLayerNames.at(layer_);
+    }
+
+    ComponentStorage &Scene::GetComponentStorage() {
+        return _ComponentStorage;
+    }
+
     TRectangle Scene::GetCullArea() const {
         auto cam = GetActiveCamera();
 
@@ -112,26 +376,134 @@ namespace NerdThings::Ngine {
         return {cam->Target.X - cam->Origin.X, cam->Target.Y - cam->Origin.Y, _CullAreaWidth, _CullAreaHeight};
     }
 
+    const Input::TInputState &Scene::GetInput() const {
+        return _Input;
+    }
+
+    Input::TInputState &Scene::GetInput() {
+        return _Input;
+    }
+
+    float Scene::GetInterpolationAlpha() const {
+        return _InterpolationAlpha;
+    }
+
     Game *Scene::GetParentGame() {
         return _ParentGame;
     }
 
+    SpatialIndex &Scene::GetSpatialIndex() {
+        return _SpatialIndex;
+    }
+
+    std::uint64_t Scene::GetUpdateNumber() const {
+        return _UpdateNumber;
+    }
+
+    EntityHandle Scene::InternalRegisterEntity(BaseEntity *ent_) {
+        unsigned int index;
+
+        // Reuse a free slot if we can
+        if (!_FreeEntitySlots.empty()) {
+            index = _FreeEntitySlots.back();
+            _FreeEntitySlots.pop_back();
+        } else {
+            index = static_cast<unsigned int>(_EntitySlots.size());
+            _EntitySlots.emplace_back();
+        }
+
+        auto &slot = _EntitySlots[index];
+        slot.Entity = ent_;
+        slot.CullListed = false;
+        slot.Drawn = false;
+
+        EntityHandle handle = {index, slot.Generation};
+
+        // Add to the spatial index, this only has the position until the entity is added to a container.
+        // The entity's handle isn't set yet, so give the index ours.
+        _SpatialIndex.Update(index, ent_, {ent_->GetPosition(), 0, 0});
+
+        // Cullable entities start active, so the next cull pass must look at them
+        if (ent_->GetCanCull()) {
+            slot.CullListed = true;
+            _CullActive.push_back(handle);
+        }
+
+        return handle;
+    }
+
+    void Scene::InternalQueueEntityCull(BaseEntity *ent_) {
+        auto &slot = _EntitySlots[ent_->GetHandle().Index];
+        if (!ent_->GetCanCull() || slot.CullListed)
+            return;
+
+        slot.CullListed = true;
+        _CullActive.push_back(ent_->GetHandle());
+    }
+
+    void Scene::InternalQueueTransformChanged(BaseEntity *ent_) {
+        _DirtyTransforms.push_back(ent_->GetHandle());
+    }
+
+    void Scene::InternalReleaseEntity(EntityHandle handle_) {
+        if (!IsEntityValid(handle_))
+            return;
+
+        auto &slot = _EntitySlots[handle_.Index];
+
+        // Stop drawing
+        RemoveDrawRecord(slot.Entity, slot.Entity->GetDepth(), slot.Entity->GetDrawWithCamera());
+
+        // Remove from the spatial index
+        _SpatialIndex.Remove(slot.Entity);
+
+        // Its handle is left in the cull list until the list is rebuilt
+        if (slot.CullListed) {
+            slot.CullListed = false;
+            _CullActiveReleased++;
+        }
+
+        slot.Entity = nullptr;
+
+        // Invalidate existing handles. Generation 0 is reserved for null handles
+        slot.Generation++;
+        if (slot.Generation == 0) slot.Generation = 1;
+
+        _FreeEntitySlots.push_back(handle_.Index);
+    }
+
     void Scene::InternalSetEntityDepth(int depth_, BaseEntity *ent_) {
-        if (_EntityDepths.find(depth_) == _EntityDepths.end())
-            _EntityDepths.insert({depth_, {}});
-        _EntityDepths[depth_].push_back(ent_);
+        InsertDrawRecord(ent_, depth_, ent_->GetDrawWithCamera(), true);
     }
 
     void Scene::InternalUpdateEntityDepth(int oldDepth_, int newDepth_, BaseEntity *ent_) {
         if (oldDepth_ == newDepth_)
             return; // Short circuit if depth's are the same because we don't want to remove and re-add
-        _EntityDepths[oldDepth_].erase(
-            std::remove(_EntityDepths[oldDepth_].begin(), _EntityDepths[oldDepth_].end(), ent_),
-            _EntityDepths[oldDepth_].end());
 
-        if (_EntityDepths.find(newDepth_) == _EntityDepths.end())
-            _EntityDepths.insert({newDepth_, {}});
-        _EntityDepths[newDepth_].push_back(ent_);
+        auto record = FindDrawRecord(ent_, oldDepth_, ent_->GetDrawWithCamera());
+        if (record == nullptr)
+            return;
+
+        auto active = record->Active;
+        RemoveDrawRecord(ent_, oldDepth_, ent_->GetDrawWithCamera());
+        InsertDrawRecord(ent_, newDepth_, ent_->GetDrawWithCamera(), active);
+    }
+
+    void Scene::InternalUpdateEntityBounds(BaseEntity *ent_) {
+        _SpatialIndex.Update(ent_, ent_->GetBounds());
+    }
+
+    void Scene::InternalUpdateEntityDrawWithCamera(bool drawWithCamera_, BaseEntity *ent_) {
+        if (drawWithCamera_ == ent_->GetDrawWithCamera())
+            return;
+
+        auto record = FindDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera());
+        if (record == nullptr)
+            return;
+
+        auto active = record->Active;
+        RemoveDrawRecord(ent_, ent_->GetDepth(), ent_->GetDrawWithCamera());
+        InsertDrawRecord(ent_, ent_->GetDepth(), drawWithCamera_, active);
     }
 
     bool Scene::IsPaused() {
@@ -142,6 +514,33 @@ namespace NerdThings::Ngine {
         _Paused = true;
     }
 
+    void Scene::QueryRect(TRectangle rect_, std::vector<BaseEntity *> &out_) {
+        _SpatialIndex.QueryRect(rect_, out_);
+    }
+
+    std::vector<BaseEntity *> Scene::QueryRect(TRectangle rect_) {
+        std::vector<BaseEntity *> vec;
+        _SpatialIndex.QueryRect(rect_, vec);
+        return vec;
+    }
+
+    void Scene::QueryRadius(TVector2 center_, float radius_, std::vector<BaseEntity *> &out_) {
+        _SpatialIndex.QueryRadius(center_, radius_, out_);
+    }
+
+    std::vector<BaseEntity *> Scene::QueryRadius(TVector2 center_, float radius_) {
+        std::vector<BaseEntity *> vec;
+        _SpatialIndex.QueryRadius(center_, radius_, vec);
+        return vec;
+    }
+
+    void Scene::RemoveSystem(SceneSystem *system_) {
+        _Systems.erase(std::remove_if(_Systems.begin(), _Systems.end(), [&](const std::unique_ptr<SceneSystem> &system) {
+            return system.get() == system_;
+        }), _Systems.end());
+        _SystemWavesDirty = true;
+    }
+
     void Scene::Resume() {
         _Paused = false;
     }
@@ -156,9 +555,19 @@ namespace NerdThings::Ngine {
         _CullAreaCenter = centerOnCamera_;
     }
 
+    void Scene::SetInput(const Input::TInputState &input_) {
+        _Input = input_;
+    }
+
     void Scene::Update() {
+        NGINE_PROFILE_SCOPE("Scene::Update");
+
+        // Entities save their transform the first time they move in a new update
+        _UpdateNumber++;
+
         if (_Paused) {
             OnPersistentUpdate({});
+            FlushTransformChanges();
             return;
         }
 
@@ -169,29 +578,20 @@ namespace NerdThings::Ngine {
         // Every half second
         if (_UpdateCounter % fps / 2 == 0) {
             // Check culling
-
-            for (auto ent : GetEntities()) {
-                if (ent != nullptr) {
-                    // Check if we can cull
-                    if (ent->GetCanCull()) {
-                        auto area = GetCullArea();
-                        if (_EntityActivities.find(ent) == _EntityActivities.end())
-                            _EntityActivities.insert({ent, true});
-                        if (!ent->CheckForCulling(area)) {
-                            _EntityActivities[ent] = true;
-                        } else {
-                            _EntityActivities[ent] = false;
-                        }
-                    }
-                }
-            }
+            CullEntities();
         }
 
         if (_UpdateCounter > fps)
             _UpdateCounter -= fps;
 
+        // Run systems
+        RunSystems();
+
         // Invoke updates
         OnUpdate({});
         OnPersistentUpdate({});
+
+        // Notify listeners of deferred transform changes
+        FlushTransformChanges();
     }
 }
@@ -18,11 +18,98 @@
 
 #include "Rectangle.h"
 #include "Graphics/Camera.h"
+#include "Physics/CollisionBroadphase.h"
+#include "ComponentStorage.h"
+#include "SceneSystem.h"
+#include "SpatialIndex.h"
 #include "EventArgs.h"
 #include "EntityContainer.h"
 #include "EventHandler.h"
+#include "Input/InputState.h"
+
+#define MAX_COLLISION_LAYERS 32
 
 namespace NerdThings::Ngine {
+    /*
+     * A scene entity slot.
+     * Used to resolve entity handles.
+     */
+    struct TEntitySlot {
+        // Public Fields
+
+        /*
+         * The last cull pass that looked at this entity
+         */
+        unsigned int CullStamp = 0;
+
+        /*
+         * Whether or not the entity is in the cull active list
+         */
+        bool CullListed = false;
+
+        /*
+         * Whether or not the entity has a draw record
+         */
+        bool Drawn = false;
+
+        /*
+         * The draw record sequence number.
+         * Used to find the entity's draw record.
+         */
+        unsigned int DrawSequence = 0;
+
+        /*
+         * The entity in this slot, null if free
+         */
+        BaseEntity *Entity = nullptr;
+
+        /*
+         * The current slot generation
+         */
+        unsigned int Generation = 1;
+    };
+
+    /*
+     * A scene draw list entry.
+     * The draw list is sorted so that camera entities come first, then by depth, then by insertion.
+     */
+    struct TDrawRecord {
+        // Public Fields
+
+        /*
+         * Whether or not the entity is active (not culled)
+         */
+        bool Active = true;
+
+        /*
+         * Whether or not the entity is drawn with the camera
+         */
+        bool DrawWithCamera = true;
+
+        /*
+         * Entity depth
+         */
+        int Depth = 0;
+
+        /*
+         * Insertion sequence, keeps sorting stable
+         */
+        unsigned int Sequence = 0;
+
+        /*
+         * The entity. Null if removed and awaiting compaction.
+         */
+        BaseEntity *Entity = nullptr;
+
+        // Operators
+
+        bool operator<(const TDrawRecord &b_) const {
+            if (DrawWithCamera != b_.DrawWithCamera) return DrawWithCamera;
+            if (Depth != b_.Depth) return Depth < b_.Depth;
+            return Sequence < b_.Sequence;
+        }
+    };
+
     /*
      * A container for entities
      */
@@ -34,6 +121,51 @@ namespace NerdThings::Ngine {
          */
         Graphics::TCamera *_ActiveCamera = nullptr;
 
+        /*
+         * Collision broadphase
+         */
+        Physics::CollisionBroadphase _CollisionBroadphase;
+
+        /*
+         * Collision layer bit indices by name
+         */
+        std::unordered_map<std::string, unsigned int> _CollisionLayers;
+
+        /*
+         * Collision layer names by bit index
+         */
+        std::vector<std::string> _CollisionLayerNames;
+
+        /*
+         * Data component storage
+         */
+        ComponentStorage _ComponentStorage;
+
+        /*
+         * Cullable entities that were active after the last cull pass, or need checking
+         */
+        std::vector<EntityHandle> _CullActive;
+
+        /*
+         * Handles in the cull active list whose entity has been released
+         */
+        size_t _CullActiveReleased = 0;
+
+        /*
+         * Scratch list for cull pass candidates
+         */
+        std::vector<BaseEntity *> _CullCandidates;
+
+        /*
+         * Scratch list for the next active set
+         */
+        std::vector<EntityHandle> _CullNextActive;
+
+        /*
+         * The current cull pass
+         */
+        unsigned int _CullStamp = 0;
+
         /*
          * Whether or not the cull area centers around
          */
@@ -50,15 +182,60 @@ namespace NerdThings::Ngine {
         float _CullAreaWidth;
 
         /*
-         * Whether or not an entity is active
+         * The sorted draw list
+         */
+        std::vector<TDrawRecord> _DrawList;
+
+        /*
+         * Records inserted while drawing, merged into the draw list once the sweep ends
+         */
+        std::vector<TDrawRecord> _DrawListPending;
+
+        /*
+         * The number of removed records in the draw list
+         */
+        unsigned int _DrawListRemoved = 0;
+
+        /*
+         * The next draw record sequence number
+         */
+        unsigned int _DrawSequence = 0;
+
+        /*
+         * Whether or not the draw list is being swept.
+         * While set, the draw list is not changed, so entities can be destroyed or moved from Draw.
+         */
+        bool _Drawing = false;
+
+        /*
+         * Entities with a deferred transform event, in the order they changed
          */
-        std::unordered_map<BaseEntity *, bool> _EntityActivities;
+        std::vector<EntityHandle> _DirtyTransforms;
 
         /*
-         * Depth key list containing entities.
-         * This is used for drawing.
+         * Entity slots, indexed by handle
          */
-        std::map<int, std::vector<BaseEntity *>> _EntityDepths;
+        std::vector<TEntitySlot> _EntitySlots;
+
+        /*
+         * Free entity slot indices
+         */
+        std::vector<unsigned int> _FreeEntitySlots;
+
+        /*
+         * Scratch list for flushing deferred transform events
+         */
+        std::vector<EntityHandle> _FlushingTransforms;
+
+        /*
+         * The input snapshot for this update
+         */
+        Input::TInputState _Input;
+
+        /*
+         * How far between the last two updates we are drawing
+         */
+        float _InterpolationAlpha = 1;
 
         /*
          * The parent game
@@ -70,25 +247,95 @@ namespace NerdThings::Ngine {
          */
         bool _Paused = false;
 
+        /*
+         * Entity spatial index
+         */
+        SpatialIndex _SpatialIndex;
+
+        /*
+         * Systems, in the order they were added
+         */
+        std::vector<std::unique_ptr<SceneSystem>> _Systems;
+
+        /*
+         * Systems grouped into waves that can run at the same time
+         */
+        std::vector<std::vector<SceneSystem *>> _SystemWaves;
+
+        /*
+         * Whether or not the system waves need rebuilding
+         */
+        bool _SystemWavesDirty = false;
+
         /*
          * The update counter
          */
         int _UpdateCounter = 0;
 
+        /*
+         * Number of updates run
+         */
+        std::uint64_t _UpdateNumber = 0;
+
         // Private Methods
 
+        /*
+         * Run culling against the cull area
+         */
+        void CullEntities();
+
+        /*
+         * Cull a single entity if we haven't this pass.
+         * Returns whether or not the entity is now active.
+         */
+        bool CullEntity(BaseEntity *ent_, TRectangle cullArea_);
+
+        /*
+         * Group systems into waves.
+         * A system runs in the wave after the last earlier system it conflicts with,
+         * so conflicting systems always run in the order they were added.
+         */
+        void BuildSystemWaves();
+
+        /*
+         * Drop removed records from the draw list.
+         * Does nothing while drawing.
+         */
+        void CompactDrawList();
+
+        /*
+         * Fire deferred transform events
+         */
+        void FlushTransformChanges();
+
+        /*
+         * Find an entity's draw record.
+         * Returns null if the entity has none.
+         */
+        TDrawRecord *FindDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_);
+
+        /*
+         * Insert a draw record for an entity.
+         * While drawing, the record is held back until the sweep ends.
+         */
+        void InsertDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_, bool active_);
+
+        /*
+         * Remove an entity's draw record
+         */
+        void RemoveDrawRecord(BaseEntity *ent_, int depth_, bool drawWithCamera_);
+
+        /*
+         * Run all systems
+         */
+        void RunSystems();
+
         void RemoveEntityParent(BaseEntity *ent_) override;
 
         void SetEntityParent(BaseEntity *ent_) override;
     public:
         // Public Fields
 
-        /*
-         * The collision map.
-         * This is controlled by collision components
-         */
-        std::unordered_map<std::string, std::vector<BaseEntity*>> CollisionMap;
-
         /*
          * On draw event
          */
@@ -99,6 +346,11 @@ namespace NerdThings::Ngine {
          */
         EventHandler<EventArgs> OnDrawCamera;
 
+        /*
+         * On everything in the scene having been drawn
+         */
+        EventHandler<EventArgs> OnDrawFinished;
+
         /*
          * On scene load
          */
@@ -134,25 +386,148 @@ namespace NerdThings::Ngine {
         // Public Methods
 
         /*
-         * Draw the scene
+         * Add a system over every entity with the given data components.
+         * func_ is called as func_(BaseEntity *, ComponentTypes &...).
+         * Mark components the system only reads as const, e.g. AddSystem<const TVelocity, TPosition>.
+         * Systems run each update before OnUpdate. Systems that don't conflict run in parallel,
+         * so they must only touch the components they declare. Data components cannot be added
+         * or removed while systems run.
+         */
+        template <typename... ComponentTypes, typename Func>
+        SceneSystem *AddSystem(Func func_) {
+            // Convert first, otherwise this overload is picked again for the unique_ptr
+            std::unique_ptr<SceneSystem> system = std::make_unique<QuerySystem<Func, ComponentTypes...>>(std::move(func_));
+            return AddSystem(std::move(system));
+        }
+
+        /*
+         * Add a system
+         */
+        SceneSystem *AddSystem(std::unique_ptr<SceneSystem> system_);
+
+        /*
+         * Draw the scene.
+         * alpha_ is how far between the last two updates this draw is, used by entities to interpolate.
          */
-        void Draw();
+        void Draw(float alpha_ = 1);
 
         /*
          * Get the currently active camera
          */
         [[nodiscard]] Graphics::TCamera *GetActiveCamera() const;
 
+        /*
+         * Get the collision broadphase
+         */
+        Physics::CollisionBroadphase &GetCollisionBroadphase();
+
+        /*
+         * Get the bit index of a named collision layer.
+         * Layers are registered the first time they are used, up to MAX_COLLISION_LAYERS.
+         */
+        unsigned int GetCollisionLayer(const std::string &name_);
+
+        /*
+         * Get the bit mask of a named collision layer
+         */
+        unsigned int GetCollisionLayerMask(const std::string &name_);
+
+        /*
+         * Get the bit mask of a named collision layer without registering it.
+         * Returns 0 if the layer has never been used.
+         */
+        [[nodiscard]] unsigned int FindCollisionLayerMask(const std::string &name_) const;
+
+        /*
+         * Get the name of a collision layer by bit index
+         */
+        [[nodiscard]] const std::string &GetCollisionLayerName(unsigned int layer_) const;
+
+        /*
+         * Run a function over every entity with all of the given data components.
+         * func_ is called as func_(BaseEntity *, ComponentTypes &...).
+         */
+        template <typename... ComponentTypes, typename Func>
+        void ForEach(Func func_) {
+            _ComponentStorage.Each<ComponentTypes...>(func_);
+        }
+
+        /*
+         * Get the data component storage
+         */
+        ComponentStorage &GetComponentStorage();
+
         /*
          * Get the culling area
          */
         TRectangle GetCullArea() const;
 
+        using EntityContainer::GetEntity;
+
+        /*
+         * Get an entity by handle.
+         * Returns null if the entity has been destroyed or is not of this type.
+         */
+        template <typename EntityType = BaseEntity>
+        EntityType *GetEntity(EntityHandle handle_) const {
+            if (!IsEntityValid(handle_))
+                return nullptr;
+            return dynamic_cast<EntityType*>(_EntitySlots[handle_.Index].Entity);
+        }
+
+        /*
+         * Get the input snapshot for this update.
+         * Use this over the global input managers, as the scene may be updating off the main thread.
+         */
+        const Input::TInputState &GetInput() const;
+
+        /*
+         * Get the input snapshot for this update, to change it.
+         * Changes, such as cancelled buttons, only affect this scene's update.
+         */
+        Input::TInputState &GetInput();
+
+        /*
+         * Get how far between the last two updates the current draw is.
+         * This is 1 outside of draws, or when the game is not interpolating.
+         */
+        [[nodiscard]] float GetInterpolationAlpha() const;
+
         /*
          * Get the parent game
          */
         Game *GetParentGame();
 
+        /*
+         * Get the entity spatial index
+         */
+        SpatialIndex &GetSpatialIndex();
+
+        /*
+         * Get the number of updates run
+         */
+        [[nodiscard]] std::uint64_t GetUpdateNumber() const;
+
+        /*
+         * Register an entity and get its handle (internally used)
+         */
+        EntityHandle InternalRegisterEntity(BaseEntity *ent_);
+
+        /*
+         * Queue an entity to be checked by the next cull pass (internally used)
+         */
+        void InternalQueueEntityCull(BaseEntity *ent_);
+
+        /*
+         * Queue an entity's deferred transform event (internally used)
+         */
+        void InternalQueueTransformChanged(BaseEntity *ent_);
+
+        /*
+         * Release an entity handle (internally used)
+         */
+        void InternalReleaseEntity(EntityHandle handle_);
+
         /*
          * Set the entity depth in the scene (internally used)
          */
@@ -163,6 +538,24 @@ namespace NerdThings::Ngine {
          */
         void InternalUpdateEntityDepth(int oldDepth_, int newDepth_, BaseEntity *ent_);
 
+        /*
+         * Update the entity bounds in the spatial index (internally used)
+         */
+        void InternalUpdateEntityBounds(BaseEntity *ent_);
+
+        /*
+         * Update whether the entity draws with the camera (internally used)
+         */
+        void InternalUpdateEntityDrawWithCamera(bool drawWithCamera_, BaseEntity *ent_);
+
+        /*
+         * Test whether an entity handle still refers to a live entity
+         */
+        [[nodiscard]] bool IsEntityValid(EntityHandle handle_) const {
+            return handle_.Index < _EntitySlots.size() && _EntitySlots[handle_.Index].Generation == handle_.Generation
+                   && _EntitySlots[handle_.Index].Entity != nullptr;
+        }
+
         /*
          * Is the scene paused
          */
@@ -173,6 +566,33 @@ namespace NerdThings::Ngine {
          */
         void Pause();
 
+        /*
+         * Find all entities with bounds overlapping a rectangle.
+         * Results are appended to out_.
+         */
+        void QueryRect(TRectangle rect_, std::vector<BaseEntity *> &out_);
+
+        /*
+         * Find all entities with bounds overlapping a rectangle.
+         */
+        std::vector<BaseEntity *> QueryRect(TRectangle rect_);
+
+        /*
+         * Find all entities with bounds within a distance of a point.
+         * Results are appended to out_.
+         */
+        void QueryRadius(TVector2 center_, float radius_, std::vector<BaseEntity *> &out_);
+
+        /*
+         * Find all entities with bounds within a distance of a point.
+         */
+        std::vector<BaseEntity *> QueryRadius(TVector2 center_, float radius_);
+
+        /*
+         * Remove a system
+         */
+        void RemoveSystem(SceneSystem *system_);
+
         /*
          * Unpause the scene
          */
@@ -188,6 +608,12 @@ namespace NerdThings::Ngine {
          */
         void SetCullArea(float width_, float height_, bool centerOnCamera_);
 
+        /*
+         * Set the input snapshot for the next update.
+         * The game sets this for the current scene, parallel scenes are fed by whoever drives them.
+         */
+        void SetInput(const Input::TInputState &input_);
+
         /*
          * Update the scene
          */
@@ -0,0 +1,136 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef SCENESYSTEM_H
+#define SCENESYSTEM_H
+
+#include "ngine.h"
+
+#include <functional>
+
+#include "ComponentStorage.h"
+#include "TypeID.h"
+
+namespace NerdThings::Ngine {
+    /*
+     * A scene system.
+     * Systems declare which data component types they read and write,
+     * systems that don't conflict are run at the same time.
+     */
+    class NEAPI SceneSystem {
+        // Private Fields
+
+        /*
+         * Component types read
+         */
+        std::vector<unsigned int> _Reads;
+
+        /*
+         * Component types written
+         */
+        std::vector<unsigned int> _Writes;
+
+    public:
+        // Destructor
+
+        virtual ~SceneSystem() = default;
+
+        // Public Methods
+
+        /*
+         * Whether or not two systems cannot run at the same time.
+         * This is the case if either writes something the other reads or writes.
+         */
+        [[nodiscard]] bool ConflictsWith(const SceneSystem &system_) const {
+            auto contains = [](const std::vector<unsigned int> &types_, unsigned int type_) {
+                return std::find(types_.begin(), types_.end(), type_) != types_.end();
+            };
+
+            for (auto type : _Writes) {
+                if (contains(system_._Reads, type) || contains(system_._Writes, type))
+                    return true;
+            }
+
+            for (auto type : system_._Writes) {
+                if (contains(_Reads, type))
+                    return true;
+            }
+
+            return false;
+        }
+
+        /*
+         * Get the component types read
+         */
+        [[nodiscard]] const std::vector<unsigned int> &GetReads() const {
+            return _Reads;
+        }
+
+        /*
+         * Get the component types written
+         */
+        [[nodiscard]] const std::vector<unsigned int> &GetWrites() const {
+            return _Writes;
+        }
+
+        /*
+         * Run the system.
+         * May be called from any thread.
+         */
+        virtual void Run(ComponentStorage &storage_) = 0;
+
+    protected:
+        // Protected Constructor(s)
+
+        SceneSystem(std::vector<unsigned int> reads_, std::vector<unsigned int> writes_)
+            : _Reads(std::move(reads_)), _Writes(std::move(writes_)) {}
+    };
+
+    /*
+     * A system running a function over every entity with a set of data components.
+     * const component types are read, others are written.
+     */
+    template <typename Func, typename... ComponentTypes>
+    class QuerySystem : public SceneSystem {
+        // Private Fields
+
+        /*
+         * The function to run
+         */
+        Func _Func;
+
+        // Private Methods
+
+        /*
+         * Get the IDs of the types with the given constness
+         */
+        static std::vector<unsigned int> GetTypes(bool const_) {
+            std::vector<unsigned int> types;
+            ((std::is_const<ComponentTypes>::value == const_ ? types.push_back(TypeID::Get<ComponentTypes>())
+                                                             : void()), ...);
+            return types;
+        }
+
+    public:
+        // Public Constructor(s)
+
+        explicit QuerySystem(Func func_)
+            : SceneSystem(GetTypes(true), GetTypes(false)), _Func(std::move(func_)) {}
+
+        // Public Methods
+
+        void Run(ComponentStorage &storage_) override {
+            storage_.Each<ComponentTypes...>(std::ref(_Func));
+        }
+    };
+}
+
+#endif //SCENESYSTEM_H
@@ -0,0 +1,191 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "SpatialIndex.h"
+
+#include <cmath>
+
+#include "BaseEntity.h"
+
+namespace NerdThings::Ngine {
+    // Private Methods
+
+    void SpatialIndex::AddToCells(unsigned int index_) {
+        const auto &entry = _Entries[index_];
+        for (auto y = entry.MinY; y <= entry.MaxY; y++) {
+            for (auto x = entry.MinX; x <= entry.MaxX; x++) {
+                _Cells[CellKey(x, y)].push_back(index_);
+            }
+        }
+    }
+
+    int SpatialIndex::CellCoord(float value_) const {
+        return static_cast<int>(std::floor(value_ / _CellSize));
+    }
+
+    long long SpatialIndex::CellKey(int x_, int y_) {
+        return (static_cast<long long>(x_) << 32) | static_cast<unsigned int>(y_);
+    }
+
+    void SpatialIndex::RemoveFromCells(unsigned int index_) {
+        const auto &entry = _Entries[index_];
+        for (auto y = entry.MinY; y <= entry.MaxY; y++) {
+            for (auto x = entry.MinX; x <= entry.MaxX; x++) {
+                auto it = _Cells.find(CellKey(x, y));
+                if (it == _Cells.end()) continue;
+
+                // Order within a cell does not matter
+                auto &cell = it->second;
+                for (size_t i = 0; i < cell.size(); i++) {
+                    if (cell[i] == index_) {
+                        cell[i] = cell.back();
+                        cell.pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Public Constructor(s)
+
+    SpatialIndex::SpatialIndex(float cellSize_)
+        : _CellSize(cellSize_) {
+        if (cellSize_ <= 0)
+            throw std::runtime_error("Spatial index cell size must be positive.");
+    }
+
+    // Public Methods
+
+    float SpatialIndex::GetCellSize() const {
+        return _CellSize;
+    }
+
+    void SpatialIndex::QueryRect(TRectangle rect_, std::vector<BaseEntity *> &out_) {
+        _QueryStamp++;
+
+        auto minX = CellCoord(rect_.X);
+        auto minY = CellCoord(rect_.Y);
+        auto maxX = CellCoord(rect_.X + rect_.Width);
+        auto maxY = CellCoord(rect_.Y + rect_.Height);
+
+        for (auto y = minY; y <= maxY; y++) {
+            for (auto x = minX; x <= maxX; x++) {
+                auto it = _Cells.find(CellKey(x, y));
+                if (it == _Cells.end()) continue;
+
+                for (auto index : it->second) {
+                    auto &entry = _Entries[index];
+                    if (entry.QueryStamp == _QueryStamp) continue;
+                    entry.QueryStamp = _QueryStamp;
+
+                    const auto &b = entry.Bounds;
+                    if (b.X <= rect_.X + rect_.Width && rect_.X <= b.X + b.Width
+                        && b.Y <= rect_.Y + rect_.Height && rect_.Y <= b.Y + b.Height)
+                        out_.push_back(entry.Entity);
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::QueryRadius(TVector2 center_, float radius_, std::vector<BaseEntity *> &out_) {
+        _QueryStamp++;
+
+        auto minX = CellCoord(center_.X - radius_);
+        auto minY = CellCoord(center_.Y - radius_);
+        auto maxX = CellCoord(center_.X + radius_);
+        auto maxY = CellCoord(center_.Y + radius_);
+        auto radiusSq = radius_ * radius_;
+
+        for (auto y = minY; y <= maxY; y++) {
+            for (auto x = minX; x <= maxX; x++) {
+                auto it = _Cells.find(CellKey(x, y));
+                if (it == _Cells.end()) continue;
+
+                for (auto index : it->second) {
+                    auto &entry = _Entries[index];
+                    if (entry.QueryStamp == _QueryStamp) continue;
+                    entry.QueryStamp = _QueryStamp;
+
+                    // Closest point on the bounds to the center
+                    const auto &b = entry.Bounds;
+                    auto dx = center_.X - std::max(b.X, std::min(center_.X, b.X + b.Width));
+                    auto dy = center_.Y - std::max(b.Y, std::min(center_.Y, b.Y + b.Height));
+
+                    if (dx * dx + dy * dy <= radiusSq)
+                        out_.push_back(entry.Entity);
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::Remove(BaseEntity *entity_) {
+        auto index = entity_->GetHandle().Index;
+        if (index >= _Entries.size() || _Entries[index].Entity != entity_)
+            return;
+
+        RemoveFromCells(index);
+        _Entries[index] = TSpatialEntry();
+    }
+
+    void SpatialIndex::SetCellSize(float cellSize_) {
+        if (cellSize_ <= 0)
+            throw std::runtime_error("Spatial index cell size must be positive.");
+
+        _CellSize = cellSize_;
+        _Cells.clear();
+
+        // Rebuild
+        for (unsigned int i = 0; i < _Entries.size(); i++) {
+            auto &entry = _Entries[i];
+            if (entry.Entity == nullptr) continue;
+
+            entry.MinX = CellCoord(entry.Bounds.X);
+            entry.MinY = CellCoord(entry.Bounds.Y);
+            entry.MaxX = CellCoord(entry.Bounds.X + entry.Bounds.Width);
+            entry.MaxY = CellCoord(entry.Bounds.Y + entry.Bounds.Height);
+            AddToCells(i);
+        }
+    }
+
+    void SpatialIndex::Update(BaseEntity *entity_, TRectangle bounds_) {
+        Update(entity_->GetHandle().Index, entity_, bounds_);
+    }
+
+    void SpatialIndex::Update(unsigned int index_, BaseEntity *entity_, TRectangle bounds_) {
+        if (index_ >= _Entries.size())
+            _Entries.resize(index_ + 1);
+
+        auto &entry = _Entries[index_];
+
+        auto minX = CellCoord(bounds_.X);
+        auto minY = CellCoord(bounds_.Y);
+        auto maxX = CellCoord(bounds_.X + bounds_.Width);
+        auto maxY = CellCoord(bounds_.Y + bounds_.Height);
+
+        entry.Bounds = bounds_;
+
+        // Still in the same cells
+        if (entry.Entity == entity_ && entry.MinX == minX && entry.MinY == minY
+            && entry.MaxX == maxX && entry.MaxY == maxY)
+            return;
+
+        if (entry.Entity != nullptr)
+            RemoveFromCells(index_);
+
+        entry.Entity = entity_;
+        entry.MinX = minX;
+        entry.MinY = minY;
+        entry.MaxX = maxX;
+        entry.MaxY = maxY;
+        AddToCells(index_);
+    }
+}
@@ -0,0 +1,153 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "ngine.h"
+
+#include "Rectangle.h"
+#include "Vector2.h"
+
+namespace NerdThings::Ngine {
+    // We do this forward declaration instead of include because BaseEntity uses this.
+    class NEAPI BaseEntity;
+
+    /*
+     * A spatial index entry
+     */
+    struct TSpatialEntry {
+        // Public Fields
+
+        /*
+         * The entity bounds
+         */
+        TRectangle Bounds;
+
+        /*
+         * The entity, null if not present
+         */
+        BaseEntity *Entity = nullptr;
+
+        /*
+         * Cell range covered, inclusive
+         */
+        int MinX = 0, MinY = 0, MaxX = -1, MaxY = -1;
+
+        /*
+         * Last query this entry was returned by.
+         * Stops entities in several cells being returned twice.
+         */
+        unsigned int QueryStamp = 0;
+    };
+
+    /*
+     * A uniform grid of entity bounds.
+     * Entities are stored in every cell their bounds touch, so queries only visit nearby cells.
+     */
+    class NEAPI SpatialIndex {
+        // Private Fields
+
+        /*
+         * Cells by packed cell coordinate
+         */
+        std::unordered_map<long long, std::vector<unsigned int>> _Cells;
+
+        /*
+         * Cell size
+         */
+        float _CellSize;
+
+        /*
+         * Entries, indexed by entity handle index
+         */
+        std::vector<TSpatialEntry> _Entries;
+
+        /*
+         * Current query stamp
+         */
+        unsigned int _QueryStamp = 0;
+
+        // Private Methods
+
+        /*
+         * Add an entry to its cells
+         */
+        void AddToCells(unsigned int index_);
+
+        /*
+         * Get the cell coordinate for a position
+         */
+        [[nodiscard]] int CellCoord(float value_) const;
+
+        /*
+         * Pack a cell coordinate
+         */
+        static long long CellKey(int x_, int y_);
+
+        /*
+         * Remove an entry from its cells
+         */
+        void RemoveFromCells(unsigned int index_);
+    public:
+        // Public Constructor(s)
+
+        /*
+         * Create a spatial index.
+         * cellSize_ should be around the size of a typical entity or view region.
+         */
+        explicit SpatialIndex(float cellSize_ = 128);
+
+        // Public Methods
+
+        /*
+         * Get the cell size
+         */
+        [[nodiscard]] float GetCellSize() const;
+
+        /*
+         * Find all entities with bounds overlapping a rectangle.
+         * Results are appended to out_.
+         */
+        void QueryRect(TRectangle rect_, std::vector<BaseEntity *> &out_);
+
+        /*
+         * Find all entities with bounds within a distance of a point.
+         * Results are appended to out_.
+         */
+        void QueryRadius(TVector2 center_, float radius_, std::vector<BaseEntity *> &out_);
+
+        /*
+         * Remove an entity
+         */
+        void Remove(BaseEntity *entity_);
+
+        /*
+         * Set the cell size.
+         * This rebuilds the index.
+         */
+        void SetCellSize(float cellSize_);
+
+        /*
+         * Insert or update an entity.
+         * Cells are only touched if the covered cell range changed.
+         */
+        void Update(BaseEntity *entity_, TRectangle bounds_);
+
+        /*
+         * Insert or update an entity at a handle index.
+         * Used while the entity is being registered, before it knows its own handle.
+         */
+        void Update(unsigned int index_, BaseEntity *entity_, TRectangle bounds_);
+    };
+}
+
+#endif //SPATIALINDEX_H
@@ -0,0 +1,268 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "JobSystem.h"
+
+namespace NerdThings::Ngine::Threading {
+    /*
+     * The job system owning the current worker thread
+     */
+    static thread_local const JobSystem *CurrentSystem = nullptr;
+
+    /*
+     * The queue owned by the current worker thread
+     */
+    static thread_local unsigned int CurrentQueue = 0;
+
+    // Private Methods
+
+    void JobSystem::FinishJob(const TJob &job_) {
+        if (job_.Counter == nullptr)
+            return;
+
+        // Decrement under the lock, so ScheduleAfter can't miss the counter finishing
+        // and Wait can't free the counter while we still hold it
+        std::vector<TJob> continuations;
+        {
+            std::lock_guard<std::mutex> lock(job_.Counter->Mutex);
+            if (job_.Counter->Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                std::swap(continuations, job_.Counter->Continuations);
+        }
+
+        for (const auto &job : continuations) {
+            Push(job);
+        }
+    }
+
+    unsigned int JobSystem::GetQueueIndex() const {
+        // Outside threads share the main queue
+        return CurrentSystem == this ? CurrentQueue : 0;
+    }
+
+    void JobSystem::Push(const TJob &job_) {
+        auto &queue = *_Queues[GetQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            queue.Jobs.push_back(job_);
+        }
+
+        _PendingJobs.fetch_add(1, std::memory_order_release);
+
+        // Take the lock so a worker about to sleep can't miss this
+        {
+            std::lock_guard<std::mutex> lock(_WakeMutex);
+        }
+        _WakeCondition.notify_one();
+    }
+
+    void JobSystem::RunJob(const TJob &job_) {
+        try {
+            job_.Function(job_.Data, job_.Index);
+        } catch (...) {
+            if (job_.Counter != nullptr) {
+                std::lock_guard<std::mutex> lock(job_.Counter->Mutex);
+                if (job_.Counter->Exception == nullptr)
+                    job_.Counter->Exception = std::current_exception();
+            } else {
+                ConsoleMessage("A job without a counter threw, the exception was dropped.", "ERROR", "JOBSYSTEM");
+            }
+        }
+
+        FinishJob(job_);
+    }
+
+    bool JobSystem::TryGetJob(unsigned int queue_, TJob &job_) {
+        // Our own queue first, newest job as it is most likely still in cache
+        {
+            auto &queue = *_Queues[queue_];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (!queue.Jobs.empty()) {
+                job_ = queue.Jobs.back();
+                queue.Jobs.pop_back();
+                _PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Steal the oldest job from someone else
+        for (size_t i = 1; i < _Queues.size(); i++) {
+            auto &queue = *_Queues[(queue_ + i) % _Queues.size()];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (!queue.Jobs.empty()) {
+                job_ = queue.Jobs.front();
+                queue.Jobs.pop_front();
+                _PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::WorkerLoop(unsigned int queue_) {
+        CurrentSystem = this;
+        CurrentQueue = queue_;
+
+        TJob job;
+        while (_Running.load(std::memory_order_acquire)) {
+            if (TryGetJob(queue_, job)) {
+                RunJob(job);
+                continue;
+            }
+
+            // Sleep until there is work
+            std::unique_lock<std::mutex> lock(_WakeMutex);
+            _WakeCondition.wait(lock, [this]() {
+                return _PendingJobs.load(std::memory_order_acquire) > 0 || !_Running.load(std::memory_order_acquire);
+            });
+        }
+
+        CurrentSystem = nullptr;
+    }
+
+    // Public Constructor(s)
+
+    JobSystem::JobSystem(unsigned int workerCount_)
+        : _MainThreadID(std::this_thread::get_id()) {
+        if (workerCount_ == 0) {
+            auto cores = std::thread::hardware_concurrency();
+            workerCount_ = cores > 1 ? cores - 1 : 1;
+        }
+
+        // One queue for the main thread, one for each worker
+        for (unsigned int i = 0; i <= workerCount_; i++) {
+            _Queues.push_back(std::make_unique<TWorkerQueue>());
+        }
+
+        CurrentSystem = this;
+        CurrentQueue = 0;
+
+        for (unsigned int i = 1; i <= workerCount_; i++) {
+            _Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+
+        ConsoleMessage("Started " + std::to_string(workerCount_) + " worker threads.", "NOTICE", "JOBSYSTEM");
+    }
+
+    // Destructor
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(_WakeMutex);
+            _Running.store(false, std::memory_order_release);
+        }
+        _WakeCondition.notify_all();
+
+        for (auto &worker : _Workers) {
+            worker.join();
+        }
+
+        if (CurrentSystem == this)
+            CurrentSystem = nullptr;
+    }
+
+    // Public Methods
+
+    unsigned int JobSystem::GetWorkerCount() const {
+        return static_cast<unsigned int>(_Workers.size());
+    }
+
+    bool JobSystem::IsMainThread() const {
+        return std::this_thread::get_id() == _MainThreadID;
+    }
+
+    void JobSystem::RunOnMainThread(std::function<void()> func_) {
+        if (IsMainThread()) {
+            func_();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_MainThreadMutex);
+        _MainThreadJobs.push_back(std::move(func_));
+    }
+
+    void JobSystem::RunMainThreadJobs() {
+        if (!IsMainThread())
+            throw std::runtime_error("Main thread jobs must be run from the main thread.");
+
+        std::vector<std::function<void()>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(_MainThreadMutex);
+            std::swap(jobs, _MainThreadJobs);
+        }
+
+        for (auto &job : jobs) {
+            job();
+        }
+    }
+
+    void JobSystem::Schedule(TJob job_, size_t count_, TJobCounter &counter_) {
+        job_.Counter = &counter_;
+        counter_.Value.fetch_add(static_cast<int>(count_), std::memory_order_acq_rel);
+
+        for (size_t i = 0; i < count_; i++) {
+            job_.Index = i;
+            Push(job_);
+        }
+    }
+
+    void JobSystem::ScheduleAfter(TJobCounter &dependency_, TJob job_, size_t count_, TJobCounter &counter_) {
+        job_.Counter = &counter_;
+        counter_.Value.fetch_add(static_cast<int>(count_), std::memory_order_acq_rel);
+
+        {
+            std::lock_guard<std::mutex> lock(dependency_.Mutex);
+
+            // The last job takes continuations under this lock, so if it isn't done yet it will see these
+            if (!dependency_.IsDone()) {
+                for (size_t i = 0; i < count_; i++) {
+                    job_.Index = i;
+                    dependency_.Continuations.push_back(job_);
+                }
+                return;
+            }
+        }
+
+        for (size_t i = 0; i < count_; i++) {
+            job_.Index = i;
+            Push(job_);
+        }
+    }
+
+    void JobSystem::Wait(TJobCounter &counter_) {
+        auto queue = GetQueueIndex();
+        auto mainThread = IsMainThread();
+
+        TJob job;
+        while (!counter_.IsDone()) {
+            if (TryGetJob(queue, job)) {
+                RunJob(job);
+                continue;
+            }
+
+            // A job may be waiting on the main thread
+            if (mainThread)
+                RunMainThreadJobs();
+
+            std::this_thread::yield();
+        }
+
+        // Make sure the last job has let go of the counter
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(counter_.Mutex);
+            std::swap(exception, counter_.Exception);
+        }
+
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,309 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "../ngine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <tuple>
+
+namespace NerdThings::Ngine::Threading {
+    struct TJobCounter;
+
+    /*
+     * A unit of work
+     */
+    struct TJob {
+        // Public Fields
+
+        /*
+         * The counter to decrement once the job is done
+         */
+        TJobCounter *Counter = nullptr;
+
+        /*
+         * User data
+         */
+        void *Data = nullptr;
+
+        /*
+         * The job function
+         */
+        void (*Function)(void *data_, size_t index_) = nullptr;
+
+        /*
+         * Job index, passed to the function
+         */
+        size_t Index = 0;
+    };
+
+    /*
+     * Counts outstanding jobs.
+     * Jobs can be scheduled to run once a counter reaches zero.
+     * A counter must be waited on with JobSystem::Wait before it is destroyed.
+     */
+    struct NEAPI TJobCounter {
+        // Public Fields
+
+        /*
+         * Jobs waiting for this counter to reach zero
+         */
+        std::vector<TJob> Continuations;
+
+        /*
+         * The first exception thrown by one of the jobs, rethrown by JobSystem::Wait
+         */
+        std::exception_ptr Exception;
+
+        /*
+         * Lock for Continuations and Exception
+         */
+        std::mutex Mutex;
+
+        /*
+         * Outstanding jobs
+         */
+        std::atomic<int> Value{0};
+
+        // Public Methods
+
+        /*
+         * Whether or not all jobs have finished
+         */
+        [[nodiscard]] bool IsDone() const {
+            return Value.load(std::memory_order_acquire) == 0;
+        }
+    };
+
+    /*
+     * A work stealing job scheduler.
+     * Each worker has its own queue and steals from the others when it runs dry.
+     * Threads waiting on a counter run jobs while they wait.
+     */
+    class NEAPI JobSystem {
+        /*
+         * A worker job queue
+         */
+        struct TWorkerQueue {
+            /*
+             * Queued jobs. The owner works from the back, thieves take from the front.
+             */
+            std::deque<TJob> Jobs;
+
+            /*
+             * Lock for Jobs
+             */
+            std::mutex Mutex;
+        };
+
+        // Private Fields
+
+        /*
+         * Jobs that must run on the main thread
+         */
+        std::vector<std::function<void()>> _MainThreadJobs;
+
+        /*
+         * Lock for _MainThreadJobs
+         */
+        std::mutex _MainThreadMutex;
+
+        /*
+         * The thread that created the job system
+         */
+        std::thread::id _MainThreadID;
+
+        /*
+         * Number of queued jobs, used to wake workers
+         */
+        std::atomic<int> _PendingJobs{0};
+
+        /*
+         * Worker queues. Queue 0 belongs to the main thread and any other outside thread.
+         */
+        std::vector<std::unique_ptr<TWorkerQueue>> _Queues;
+
+        /*
+         * Whether or not workers should keep running
+         */
+        std::atomic<bool> _Running{true};
+
+        /*
+         * Worker wake signal
+         */
+        std::condition_variable _WakeCondition;
+
+        /*
+         * Lock for _WakeCondition
+         */
+        std::mutex _WakeMutex;
+
+        /*
+         * Worker threads
+         */
+        std::vector<std::thread> _Workers;
+
+        // Private Methods
+
+        /*
+         * Finish a job, releasing continuations if its counter hits zero
+         */
+        void FinishJob(const TJob &job_);
+
+        /*
+         * Get the queue index for the current thread
+         */
+        [[nodiscard]] unsigned int GetQueueIndex() const;
+
+        /*
+         * Push a job onto a queue and wake a worker
+         */
+        void Push(const TJob &job_);
+
+        /*
+         * Run and finish a job.
+         * Anything thrown is kept in the job's counter, so it never escapes onto a worker.
+         */
+        void RunJob(const TJob &job_);
+
+        /*
+         * Take a job from our own queue, or steal one.
+         */
+        bool TryGetJob(unsigned int queue_, TJob &job_);
+
+        /*
+         * Worker thread loop
+         */
+        void WorkerLoop(unsigned int queue_);
+
+        /*
+         * Run a function over a range of indices
+         */
+        template <typename Func>
+        static void RunParallelForBatch(void *data_, size_t index_) {
+            auto &context = *static_cast<std::tuple<Func *, size_t, size_t> *>(data_);
+            auto start = index_ * std::get<1>(context);
+            auto end = std::min(start + std::get<1>(context), std::get<2>(context));
+            (*std::get<0>(context))(start, end);
+        }
+
+        /*
+         * Run a callable
+         */
+        template <typename Func>
+        static void RunCallable(void *data_, size_t index_) {
+            (*static_cast<Func *>(data_))();
+        }
+
+    public:
+        // Public Constructor(s)
+
+        /*
+         * Create a job system.
+         * If workerCount_ is 0, one worker is created for each core besides this one.
+         */
+        explicit JobSystem(unsigned int workerCount_ = 0);
+
+        // Destructor
+
+        ~JobSystem();
+
+        // Public Methods
+
+        /*
+         * Get the number of worker threads, not including the main thread
+         */
+        [[nodiscard]] unsigned int GetWorkerCount() const;
+
+        /*
+         * Whether or not the current thread is the main thread
+         */
+        [[nodiscard]] bool IsMainThread() const;
+
+        /*
+         * Run func_(start, end) over [0, count_) in batches of batchSize_, across all threads.
+         * Blocks until every batch has run. The calling thread helps.
+         * If a batch throws, the first exception is rethrown once every batch has finished.
+         */
+        template <typename Func>
+        void ParallelFor(size_t count_, size_t batchSize_, Func func_) {
+            if (count_ == 0) return;
+            if (batchSize_ == 0) batchSize_ = 1;
+
+            // Not worth scheduling
+            if (count_ <= batchSize_) {
+                func_(static_cast<size_t>(0), count_);
+                return;
+            }
+
+            std::tuple<Func *, size_t, size_t> context(&func_, batchSize_, count_);
+
+            TJob job;
+            job.Function = &RunParallelForBatch<Func>;
+            job.Data = &context;
+
+            TJobCounter counter;
+            Schedule(job, (count_ + batchSize_ - 1) / batchSize_, counter);
+            Wait(counter);
+        }
+
+        /*
+         * Queue a function to run on the main thread.
+         * If called from the main thread, it runs now.
+         */
+        void RunOnMainThread(std::function<void()> func_);
+
+        /*
+         * Run queued main thread functions.
+         * Called by the game loop, must be called from the main thread.
+         */
+        void RunMainThreadJobs();
+
+        /*
+         * Schedule count_ copies of a job, with indices 0 to count_ - 1.
+         * The counter is raised by count_ and lowered as each finishes.
+         */
+        void Schedule(TJob job_, size_t count_, TJobCounter &counter_);
+
+        /*
+         * Schedule a callable.
+         * The callable must outlive the counter reaching zero.
+         */
+        template <typename Func>
+        void Schedule(Func &func_, TJobCounter &counter_) {
+            TJob job;
+            job.Function = &RunCallable<Func>;
+            job.Data = &func_;
+            Schedule(job, 1, counter_);
+        }
+
+        /*
+         * Schedule count_ copies of a job once a dependency counter reaches zero.
+         * The counter is raised immediately.
+         */
+        void ScheduleAfter(TJobCounter &dependency_, TJob job_, size_t count_, TJobCounter &counter_);
+
+        /*
+         * Wait for a counter to reach zero, running jobs in the meantime.
+         * If one of the counter's jobs threw, the first exception is rethrown once the counter is done.
+         */
+        void Wait(TJobCounter &counter_);
+    };
+}
+
+#endif //JOBSYSTEM_H
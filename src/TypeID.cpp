@@ -0,0 +1,23 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#include "TypeID.h"
+
+#include <atomic>
+
+namespace NerdThings::Ngine {
+    // Private Methods
+
+    unsigned int TypeID::Next() {
+        static std::atomic<unsigned int> counter{0};
+        return counter++;
+    }
+}
@@ -0,0 +1,53 @@
+/**********************************************************************************************
+*
+*   Ngine - A (mainly) 2D game engine.
+*
+*   Copyright (C) 2019 NerdThings
+*
+*   LICENSE: Apache License 2.0
+*   View: https://github.com/NerdThings/Ngine/blob/master/LICENSE
+*
+**********************************************************************************************/
+
+#ifndef TYPEID_H
+#define TYPEID_H
+
+#include "ngine.h"
+
+namespace NerdThings::Ngine {
+    /*
+     * Small sequential per-type IDs.
+     * These are cheaper than std::type_index to compare and hash, and can index arrays directly.
+     * IDs are assigned on first use, so they are not stable between runs.
+     */
+    class NEAPI TypeID {
+        // Private Methods
+
+        /*
+         * Get the next free ID
+         */
+        static unsigned int Next();
+    public:
+        // Public Methods
+
+        /*
+         * Get the ID for a type.
+         * cv qualifiers are ignored.
+         */
+        template <typename Type>
+        static unsigned int Get() {
+            return GetImpl<typename std::remove_cv<Type>::type>();
+        }
+
+    private:
+        // Private Methods
+
+        template <typename Type>
+        static unsigned int GetImpl() {
+            static const unsigned int id = Next();
+            return id;
+        }
+    };
+}
+
+#endif //TYPEID_H
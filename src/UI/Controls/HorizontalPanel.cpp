@@ -63,8 +63,8 @@ namespace NerdThings::Ngine::UI::Controls {
             offset += childStyle.Margin[1];
             offset += childStyle.Margin[3];
 
-            // Width
-            offset += childStyle.GetBorderRect(child->GetRenderRectangle()).Width;
+            // Width. Only the size is needed, asking for the rectangle would lay out every child beside it again
+            offset += childStyle.GetBorderDimensions({child->GetWidth(), child->GetHeight()}).X;
         }
 
         return offset;
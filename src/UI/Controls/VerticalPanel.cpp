@@ -45,8 +45,8 @@ namespace NerdThings::Ngine::UI::Controls {
             offset += childStyle.Margin[0];
             offset += childStyle.Margin[2];
 
-            // Height
-            offset += childStyle.GetBorderRect(child->GetRenderRectangle()).Height;
+            // Height. Only the size is needed, asking for the rectangle would lay out every child above it again
+            offset += childStyle.GetBorderDimensions({child->GetWidth(), child->GetHeight()}).Y;
         }
 
         return offset;
@@ -90,6 +90,12 @@ namespace NerdThings::Ngine::UI {
         }
     }
 
+    Scene *UIControl::GetParentScene() {
+        if (_Parent != nullptr)
+            return _Parent->GetParentScene();
+        return nullptr;
+    }
+
     TUIStyle UIControl::GetGlobalStyle(std::type_index type_) {
         if (_GlobalStyles.find(type_) != _GlobalStyles.end())
             return _GlobalStyles[type_];
@@ -17,6 +17,10 @@
 #include "Vector2.h"
 #include "UIStyle.h"
 
+namespace NerdThings::Ngine {
+    class NEAPI Scene;
+}
+
 namespace NerdThings::Ngine::UI {
     class NEAPI UIPanel;
 
@@ -97,6 +101,11 @@ namespace NerdThings::Ngine::UI {
             return _ChildrenOrdered;
         }
 
+        /*
+         * Get the scene the control's widget is in, if any
+         */
+        virtual Scene *GetParentScene();
+
         /*
          * Get a global style for a control
          */
@@ -12,6 +12,7 @@
 #include "UIControlInteractible.h"
 
 #include "../Input/Mouse.h"
+#include "../Scene.h"
 
 namespace NerdThings::Ngine::UI {
     // Public Methods
@@ -21,8 +22,10 @@ namespace NerdThings::Ngine::UI {
         auto style = GetStyle();
         auto rect = style.GetBorderRect(GetLogicRectangle());
 
-        // Check for mouse click
-        auto mState = Input::Mouse::GetMouseState();
+        // Check for mouse click.
+        // Use the scene's input, the scene may be updating off the main thread.
+        auto scene = GetParentScene();
+        auto mState = scene != nullptr ? scene->GetInput().Mouse : Input::Mouse::GetMouseState();
 
         // Check the mouse is within our parent too, if not we cant be clicked
         auto par = GetParent<UIControl>();
@@ -40,7 +43,10 @@ namespace NerdThings::Ngine::UI {
                 OnClick({this});
 
                 // Deregister click so double events dont happen
-                Input::Mouse::CancelButton(MOUSE_BUTTON_LEFT);
+                if (scene != nullptr)
+                    scene->GetInput().CancelButton(MOUSE_BUTTON_LEFT);
+                else
+                    Input::Mouse::CancelButton(MOUSE_BUTTON_LEFT);
             } else if (!_Hovered) {
                 // Hovered
                 OnHover({this});
@@ -12,12 +12,14 @@
 #include "UIPanel.h"
 
 #include "../Graphics/Drawing.h"
+#include "../Graphics/GraphicsManager.h"
 #include "UIWidget.h"
 
 namespace NerdThings::Ngine::UI {
     // Destructor
 
     UIPanel::~UIPanel() {
+        Graphics::GraphicsManager::ReleaseOnMainThread(std::move(_RenderTarget));
     }
 
     // Public Methods
@@ -25,6 +27,14 @@ namespace NerdThings::Ngine::UI {
     void UIPanel::Draw() {
         DrawStyles();
 
+        // Created on first draw, so panels can be laid out without a graphics context
+        // Render targets must be made with the graphics context
+        if (_RenderTarget == nullptr) {
+            Graphics::GraphicsManager::RunOnMainThread([&]() {
+                _RenderTarget = std::make_shared<Graphics::TRenderTarget>(static_cast<int>(GetWidth()), static_cast<int>(GetHeight()));
+            });
+        }
+
         Graphics::GraphicsManager::PushTarget(_RenderTarget);
 
         Graphics::Drawing::Clear(Graphics::TColor::Transparent);
@@ -75,6 +85,13 @@ namespace NerdThings::Ngine::UI {
             return UIControl::GetRenderPosition();
     }
 
+    Scene *UIPanel::GetParentScene() {
+        if (_ParentWidget != nullptr)
+            return _ParentWidget->GetParentScene();
+        else
+            return UIControl::GetParentScene();
+    }
+
     void UIPanel::InternalSetParentWidget(UIWidget *widget_) {
         _ParentWidget = widget_;
     }
@@ -82,13 +99,15 @@ namespace NerdThings::Ngine::UI {
     void UIPanel::SetHeight(float height_) {
         UIControlSized::SetHeight(height_);
 
-        _RenderTarget = std::make_shared<Graphics::TRenderTarget>(static_cast<int>(GetWidth()), static_cast<int>(height_));
+        // Recreated at the new size next draw
+        _RenderTarget = nullptr;
     }
 
     void UIPanel::SetWidth(float width_) {
         UIControlSized::SetWidth(width_);
 
-        _RenderTarget = std::make_shared<Graphics::TRenderTarget>(static_cast<int>(width_), static_cast<int>(GetHeight()));
+        // Recreated at the new size next draw
+        _RenderTarget = nullptr;
     }
 
     void UIPanel::Update() {
@@ -101,8 +120,5 @@ namespace NerdThings::Ngine::UI {
         SetHeight(height_);
         SetWidth(width_);
         _ChildrenConfig = 3; // Allow multiple children
-
-        // Create render target
-        _RenderTarget = std::make_shared<Graphics::TRenderTarget>(static_cast<int>(width_), static_cast<int>(height_));
     }
 }
\ No newline at end of file
@@ -35,7 +35,7 @@ namespace NerdThings::Ngine::UI {
         UIWidget *_ParentWidget = nullptr;
 
         /*
-         * The panel render target
+         * The panel render target, created on first draw
          */
         std::shared_ptr<Graphics::TRenderTarget> _RenderTarget = nullptr;
     public:
@@ -91,6 +91,11 @@ namespace NerdThings::Ngine::UI {
          */
         TVector2 GetRenderPosition() override;
 
+        /*
+         * Get the scene the parent widget is in, if any
+         */
+        Scene *GetParentScene() override;
+
         /*
          * Set the parent widget.
          * For internal use only.
@@ -27,6 +27,10 @@ namespace NerdThings::Ngine::UI {
             _Panel->Draw();
     }
 
+    Scene *UIWidget::GetParentScene() {
+        return _ParentScene;
+    }
+
     TVector2 UIWidget::GetPosition() {
         return _Position;
     }
@@ -36,6 +40,10 @@ namespace NerdThings::Ngine::UI {
         _Panel->InternalSetParentWidget(this);
     }
 
+    void UIWidget::SetParentScene(Scene *scene_) {
+        _ParentScene = scene_;
+    }
+
     void UIWidget::SetPosition(TVector2 pos_) {
         _Position = pos_;
     }
@@ -29,6 +29,11 @@ namespace NerdThings::Ngine::UI {
          */
         UIPanel *_Panel = nullptr;
 
+        /*
+         * The scene the widget is in
+         */
+        Scene *_ParentScene = nullptr;
+
         /*
          * Widget position
          */
@@ -61,6 +66,11 @@ namespace NerdThings::Ngine::UI {
             return dynamic_cast<PanelType *>(_Panel);
         }
 
+        /*
+         * Get the scene the widget is in, if any
+         */
+        Scene *GetParentScene();
+
         /*
          * Get the position of the widget
          */
@@ -71,6 +81,12 @@ namespace NerdThings::Ngine::UI {
          */
         void SetPanel(UIPanel *panel_);
 
+        /*
+         * Set the scene the widget is in.
+         * Controls read their input from this scene.
+         */
+        void SetParentScene(Scene *scene_);
+
         /*
          * Set the position of the widget
          */
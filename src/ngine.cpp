@@ -11,6 +11,8 @@
 
 #include "ngine.h"
 
+#include <mutex>
+
 #ifdef INCLUDE_BOX2D
 bool b2TestOverlap(const b2Shape* shapeA, const b2Shape* shapeB) {
     b2Transform nope;
@@ -21,7 +23,8 @@ bool b2TestOverlap(const b2Shape* shapeA, const b2Shape* shapeB) {
 
 // ConsoleMessage
 void ConsoleMessage(std::string message, std::string severity, std::string module) {
-    {
-        std::cout << "[" + module + "] " + severity + ": " + message << std::endl;
-    }
+    // Messages may come from any thread
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cout << "[" + module + "] " + severity + ": " + message << std::endl;
 }
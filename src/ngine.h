@@ -150,7 +150,28 @@ namespace NerdThings::Ngine {
         /*
          * Whether or not to maintain the dimensions provided to the game constructor
          */
-        MAINTAIN_DIMENSIONS = 512
+        MAINTAIN_DIMENSIONS = 512,
+
+        /*
+         * Run without a window, graphics context, audio device or input.
+         * Only updates are run. This is not a raylib flag.
+         */
+        HEADLESS = 1024,
+
+        /*
+         * Draw entities between their transforms before and after the last update.
+         * Smooths motion when the draw and update rates differ, at the cost of up to one update of latency.
+         * This is not a raylib flag.
+         */
+        INTERPOLATE_TRANSFORMS = 2048,
+
+        /*
+         * Update and record draws on a simulation thread, while the main thread draws the previous frame.
+         * Updates and draws must not create graphics resources or call raylib outside of Graphics::Drawing,
+         * use JobSystem::RunOnMainThread for those. Mouse events and audio updates run on the main thread.
+         * This is not a raylib flag.
+         */
+        PIPELINED = 4096
     };
 
     /*
@@ -502,6 +523,26 @@ namespace NerdThings::Ngine {
         WRAP_MIRROR_CLAMP
     };
 
+    /*
+     * Color blending mode
+     */
+    enum EBlendMode {
+        /*
+         * Blend by alpha
+         */
+        BLEND_ALPHA = 0,
+
+        /*
+         * Add colors together
+         */
+        BLEND_ADDITIVE,
+
+        /*
+         * Multiply colors together
+         */
+        BLEND_MULTIPLIED
+    };
+
     /*
      * Horizontal alignment enum
      */